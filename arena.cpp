@@ -0,0 +1,77 @@
+#include <cstdint>
+
+#include "arena.h"
+
+namespace asc
+{
+    arena::arena(size_t chunk_size)
+    {
+        this->cursor = nullptr;
+        this->limit = nullptr;
+        this->chunk_size = chunk_size;
+        this->bytes_allocated = 0;
+        this->bytes_reserved = 0;
+        this->objects = 0;
+    }
+
+    /**
+     * @brief Takes memory from the newest chunk, starting a new chunk when it does not fit.
+     * Requests larger than a chunk get a chunk of their own so the free space of the newest one is not thrown away.
+     *
+     * @param size Bytes needed
+     * @param alignment Alignment of the memory, a power of two no larger than the alignment of new
+     * @return Memory owned by the arena
+     */
+    void* arena::allocate(size_t size, size_t alignment)
+    {
+        size_t padding = cursor != nullptr ? (alignment - (uintptr_t) cursor % alignment) % alignment : 0;
+        if (cursor == nullptr || padding + size > (size_t) (limit - cursor))
+        {
+            if (size > chunk_size)
+            {
+                char* chunk = new char[size];
+                chunks.insert(chunks.end() - (chunks.empty() ? 0 : 1), chunk); // keep the newest chunk last
+                bytes_reserved += size;
+                bytes_allocated += size;
+                return chunk;
+            }
+            char* chunk = new char[chunk_size];
+            chunks.push_back(chunk);
+            bytes_reserved += chunk_size;
+            cursor = chunk;
+            limit = chunk + chunk_size;
+            padding = 0;
+        }
+        char* memory = cursor + padding;
+        cursor = memory + size;
+        bytes_allocated += padding + size;
+        return memory;
+    }
+
+    // Destroys every object made in the arena and frees its chunks
+    void arena::release()
+    {
+        for (auto it = destructors.rbegin(); it != destructors.rend(); it++)
+            it->destroy(it->object);
+        destructors.clear();
+        for (char* chunk : chunks)
+            delete[] chunk;
+        chunks.clear();
+        cursor = nullptr;
+        limit = nullptr;
+        bytes_allocated = 0;
+        bytes_reserved = 0;
+        objects = 0;
+    }
+
+    std::string arena::report()
+    {
+        return "arena: " + std::to_string(bytes_allocated) + " bytes allocated to " + std::to_string(objects) + " objects, " +
+            std::to_string(bytes_reserved) + " bytes reserved in " + std::to_string(chunks.size()) + " chunks";
+    }
+
+    arena::~arena()
+    {
+        release();
+    }
+}
\ No newline at end of file
@@ -0,0 +1,64 @@
+#ifndef ARENA_H
+#define ARENA_H
+
+#include <string>
+#include <vector>
+#include <utility>
+#include <type_traits>
+#include <cstddef>
+
+namespace asc
+{
+    const size_t ARENA_CHUNK_SIZE = 64 * 1024;
+
+    /**
+     * @brief Bump allocator which owns every object made through it until it is released.
+     * Memory is carved out of large chunks by moving a cursor, and objects which need their destructor run
+     * are remembered so a release destroys them all, newest first, before handing the chunks back at once.
+     */
+    class arena
+    {
+    private:
+        typedef struct destructor_record
+        {
+            void (*destroy)(void*);
+            void* object;
+        } destructor_record;
+
+        std::vector<char*> chunks;
+        std::vector<destructor_record> destructors;
+        char* cursor; // next free byte of the newest chunk
+        char* limit; // end of the newest chunk
+        size_t chunk_size;
+
+        template <typename T> static void destroy(void* object)
+        {
+            static_cast<T*>(object)->~T();
+        }
+    public:
+        size_t bytes_allocated; // handed out to objects, including alignment padding
+        size_t bytes_reserved; // taken from the system for chunks
+        size_t objects;
+
+        arena(size_t chunk_size = ARENA_CHUNK_SIZE);
+        arena(const arena&) = delete;
+        arena& operator=(const arena&) = delete;
+        void* allocate(size_t size, size_t alignment);
+
+        // Constructs an object in the arena, it lives until the arena is released
+        template <typename T, typename... Args> T* make(Args&&... args)
+        {
+            T* object = new (allocate(sizeof(T), alignof(T))) T(std::forward<Args>(args)...);
+            if (!std::is_trivially_destructible<T>::value)
+                destructors.push_back({ &destroy<T>, object });
+            objects++;
+            return object;
+        }
+
+        void release();
+        std::string report();
+        ~arena();
+    };
+}
+
+#endif
\ No newline at end of file
@@ -1,44 +1,25 @@
 #include <iostream>
+#include <chrono>
+#include <algorithm>
+#include <functional>
 
 #include "cli.h"
 #include "logger.h"
 #include "util.h"
 #include "tokenizer.h"
 #include "parser.h"
-
-std::string SRC_ASSEMBLER = "nasm";
-std::string SRC_LINKER = "gcc";
-std::vector<std::string> OBJECT_FILES;
-namespace asc
-{
-    asc::arg_result args;
-}
+#include "builder.h"
+#include "source.h"
+#include "scanner.h"
+#include "cache.h"
+#include "jobs.h"
+#include "build.h"
+#include "context.h"
 
 int main(int argc, char* argv[])
 {
-    // init keyword regex pattern
-    asc::KEYWORD_REGEX_PATTERN += "\\b(";
-    for (auto it = asc::STANDARD_KEYWORDS.cbegin(); it != asc::STANDARD_KEYWORDS.cend(); it++)
-        asc::KEYWORD_REGEX_PATTERN += (it != asc::STANDARD_KEYWORDS.cbegin() ? "|" : "") + *it;
-    asc::KEYWORD_REGEX_PATTERN += ")\\b";
-
-    // init tokenizer regex pattern
-    // keywords
-    for (auto it = asc::STANDARD_KEYWORDS.cbegin(); it != asc::STANDARD_KEYWORDS.cend(); it++)
-        asc::TOKENIZER_REGEX_PATTERN += (asc::TOKENIZER_REGEX_PATTERN.length() != 0 ? "|" : "") + *it;
-    // strings
-    asc::TOKENIZER_REGEX_PATTERN += (asc::TOKENIZER_REGEX_PATTERN.length() != 1 ? "|" : "") + 
-        std::string("\\\"[^\\\"\\\\\\\\]*(\\\\\\\\.[^\\\"\\\\\\\\]*)*\\\"");
-    // numeric literals
-    asc::TOKENIZER_REGEX_PATTERN += "|\\b0x[a-fA-F0-9]+L*l*|0b[0-1]+L*l*|[0-9]+\\.[0-9]+D*F*d*f*|[0-9]+D*F*d*f*L*l*\\b"; // number pattern
-    // punctuators
-    for (auto it = asc::STANDARD_PUNCTUATORS.cbegin(); it != asc::STANDARD_PUNCTUATORS.cend(); it++)
-    {
-        std::string punctuator = *it;
-        asc::TOKENIZER_REGEX_PATTERN += '|' + asc::escape_chars_regex(punctuator);
-    }
-    // identifiers
-    asc::TOKENIZER_REGEX_PATTERN += "|\\w+";
+    std::string assembler = "nasm";
+    std::string linker = "gcc";
     std::ifstream ois = std::ifstream("options.cfg");
     if (ois.fail())
         asc::warn("no options file found, using default options");
@@ -47,216 +28,453 @@ int main(int argc, char* argv[])
         auto options = asc::map_cfg_file(ois);
         try
         {
-            SRC_ASSEMBLER = options.at("assembler");
+            assembler = options.at("assembler");
         }
         catch (std::out_of_range e)
         {
             asc::warn("no assembler specified, using default assembler");
-            SRC_ASSEMBLER = "nasm";
         }
         try
         {
-            SRC_LINKER = options.at("linker");
+            linker = options.at("linker");
         }
         catch (std::out_of_range e)
         {
             asc::warn("no linker specified, using default linker");
-            SRC_LINKER = "gcc";
         }
     }
-    asc::args = asc::eval_args(argc, argv);
-    if (asc::has_option_set(asc::args, asc::cli_options::HELP))
+    asc::compilation_context ctx(asc::eval_args(argc, argv));
+    ctx.assembler = assembler;
+    ctx.linker = linker;
+    asc::enable_debug(ctx.option(asc::cli_options::DEBUG)); // the logger is set up once, before anything logs debug information
+    if (!ctx.args.cache_directory.empty())
+        ctx.tokens.open(ctx.args.cache_directory);
+    if (ctx.option(asc::cli_options::HELP))
     {
         std::cout << "Usage: asc [options] file..." << std::endl;
         std::cout << "Options:" << std::endl;
         for (int i = 0; i < asc::REFERENCE_OPTIONS.size(); i++)
         {
-            asc::help_reference& hr = asc::REFERENCE_OPTIONS[i];
+            const asc::help_reference& hr = asc::REFERENCE_OPTIONS[i];
             std::cout << "  " << hr.name << "\t\t" << hr.description << std::endl;
         }
         return 0;
     }
-    if (asc::args.files.size() <= 0)
+    if (ctx.args.files.size() <= 0)
     {
         asc::err("no input files");
         return -1;
     }
-    if (asc::has_option_set(asc::args, asc::cli_options::TOKENIZE))
+    if (ctx.option(asc::cli_options::TOKENIZE))
+    {
+        for (auto const& file : ctx.args.files)
+        {
+            if (asc::visually_tokenize(ctx, file) == -1)
+                return -1;
+        }
+        if (ctx.tokens.enabled())
+            asc::info(ctx.tokens.report());
+        return 0;
+    }
+    if (ctx.option(asc::cli_options::AST))
+    {
+        for (auto const& file : ctx.args.files)
+        {
+            if (asc::dump_syntax_tree(ctx, file) == -1)
+                return -1;
+        }
+        return 0;
+    }
+    if (ctx.option(asc::cli_options::BENCHMARK))
     {
-        for (auto const& file : asc::args.files)
+        for (auto const& file : ctx.args.files)
         {
-            if (asc::visually_tokenize(file) == -1)
+            if (asc::benchmark_tokenizers(ctx, file) == -1)
                 return -1;
         }
         return 0;
     }
-    if (asc::has_option_set(asc::args, asc::cli_options::EXPRESSIONS))
+    if (ctx.option(asc::cli_options::EXPRESSIONS))
     {
-        for (auto const& file : asc::args.files)
-            asc::analyze_expressions(file);
+        for (auto const& file : ctx.args.files)
+            asc::analyze_expressions(ctx, file);
         return 0;
     }
-    for (auto const& file : asc::args.files)
+    ctx.builds.open(ctx.args.output_location + ".build");
+    for (auto const& file : ctx.args.files)
     {
-        if (asc::compile(file) == -1)
+        if (asc::compile(ctx, file) == -1)
             return -1;
     }
-    if (SRC_LINKER == "gcc" || SRC_LINKER == "ld")
+    asc::finish_assembling(ctx); // the object files have to be there before they are linked
+    if (ctx.tokens.enabled())
+        asc::info(ctx.tokens.report());
+    asc::summarize_build(ctx);
+    std::string relink = ctx.builds.relink_reason(ctx.modules, ctx.object_files, ctx.args.output_location);
+    if (relink.empty())
+    {
+        asc::info("program is up to date, not linking");
+        return 0;
+    }
+    asc::info("linking program: " + relink);
+    if (ctx.linker == "gcc" || ctx.linker == "ld")
     {
-        std::string cmd = SRC_LINKER + " -o " + asc::args.output_location;
-        for (auto& file : OBJECT_FILES)
+        std::string cmd = ctx.linker + " -o " + ctx.args.output_location;
+        for (auto& file : ctx.object_files)
             cmd += ' ' + file;
         system(cmd.c_str());
     }
     else
     {
-        asc::err("linking with unsupported linker: " + SRC_LINKER);
+        asc::err("linking with unsupported linker: " + ctx.linker);
         return -1;
     }
     asc::info("object code has been linked and executable has been created");
+    ctx.builds.store(ctx.modules, ctx.option(asc::cli_options::EXPERIMENTAL), ctx.object_files);
     return 0;
 }
 namespace asc
 {
-    int stable_compile(std::string& filepath)
+    // Waits for the assembler, which runs on files once they are compiled with as many at once as the -j option allows
+    void finish_assembling(compilation_context& ctx)
+    {
+        ctx.assembler_jobs.wait();
+    }
+
+    // Lists the modules this run compiled and why, the others were reused from their last build
+    void summarize_build(compilation_context& ctx)
+    {
+        std::vector<module*>& all = ctx.modules.modules;
+        long rebuilt = std::count_if(all.begin(), all.end(), [](module* m) { return !m->rebuilt.empty(); });
+        asc::info("rebuilt " + std::to_string(rebuilt) + " of " + std::to_string(all.size()) + " modules");
+        for (module* m : all)
+        {
+            if (!m->rebuilt.empty())
+                asc::info("  " + m->filepath + ": " + m->rebuilt);
+        }
+    }
+
+    /**
+     * @brief Parses a source file into a syntax tree, then lowers it to assembly, assembles it and queues it for linking
+     * @param root Whether the file was given on the command line, only those need an entry point
+     */
+    static int compile_file(compilation_context& ctx, std::string& filepath, asc::module& m, bool experimental, bool root)
     {
         if (!asc::ends_with(filepath, ".as"))
         {
             asc::err(filepath + " is not A# source code");
             return -1;
         }
-        std::ifstream is = std::ifstream(filepath);
-        asc::syntax_node* current = asc::tokenize(is);
-        asc::syntax_node* head = current;
-        for (; current != nullptr; current = current->next)
-            asc::debug(current->stringify());
-        asc::parser ps = asc::parser(head);
-        while (ps.parseable())
-        {
-            asc::debug("token: " + *(ps.current->value));
-            asc::evaluation_state es_be = ps.eval_block_ending();
-            asc::debug("block ending: " + std::to_string((int) es_be));
-            if (es_be == asc::STATE_FOUND)
-                continue;
-            if (es_be == asc::STATE_SYNTAX_ERROR)
-                return -1;
-            asc::evaluation_state es_ue = ps.eval_use();
-            asc::debug("use: " + std::to_string((int) es_ue));
-            if (es_ue == asc::STATE_FOUND)
-                continue;
-            if (es_ue == asc::STATE_SYNTAX_ERROR)
-                return -1;
-            asc::evaluation_state es_rs = ps.eval_return_statement();
-            asc::debug("return statement: " + std::to_string((int) es_rs));
-            if (es_rs == asc::STATE_FOUND)
-                continue;
-            if (es_rs == asc::STATE_SYNTAX_ERROR)
-                return -1;
-            asc::evaluation_state es_dl = ps.eval_delete_statement();
-            asc::debug("delete statement: " + std::to_string((int) es_dl));
-            if (es_dl == asc::STATE_FOUND)
-                continue;
-            if (es_dl == asc::STATE_SYNTAX_ERROR)
-                return -1;
-            asc::evaluation_state es_fd = ps.eval_function_header();
-            asc::debug("function decl: " + std::to_string((int) es_fd));
-            if (es_fd == asc::STATE_FOUND)
-                continue;
-            if (es_fd == asc::STATE_SYNTAX_ERROR)
-                return -1;
-            asc::evaluation_state es_vd = ps.eval_var_declaration();
-            asc::debug("variable decl: " + std::to_string((int) es_vd));
-            if (es_vd == asc::STATE_FOUND)
-                continue;
-            if (es_vd == asc::STATE_SYNTAX_ERROR)
-                return -1;
-            asc::evaluation_state es_tc = ps.eval_type_construct();
-            asc::debug("type construct: " + std::to_string((int) es_tc));
-            if (es_tc == asc::STATE_FOUND)
-                continue;
-            if (es_tc == asc::STATE_SYNTAX_ERROR)
-                return -1;
-            asc::evaluation_state es_oc = ps.eval_object_construct();
-            asc::debug("object construct: " + std::to_string((int) es_oc));
-            if (es_oc == asc::STATE_FOUND)
-                continue;
-            if (es_oc == asc::STATE_SYNTAX_ERROR)
-                return -1;
-            asc::evaluation_state es_exp = ps.eval_expression();
-            asc::debug("expression: " + std::to_string((int) es_exp));
-            if (es_exp == asc::STATE_FOUND)
-                continue;
-            if (es_exp == asc::STATE_SYNTAX_ERROR)
-                return -1;
-            asc::err("unknown statement", ps.current->line);
+        asc::source_file source(filepath);
+        if (!source.good())
+        {
+            asc::err("could not read " + filepath);
             return -1;
         }
-        asc::symbol* entry = ps.symbol_table_get(ps.as.entry);
-        if (entry == nullptr)
+        bool streaming = ctx.option(asc::cli_options::STREAM);
+        asc::token_buffer tokens = streaming ? asc::stream_tokens(source) : asc::tokenize(ctx, source);
+        if (!streaming) // listing a streamed buffer would pull every token into it
+        {
+            for (asc::token_cursor current = tokens.begin(); !current.eof(); current = current.next())
+                asc::debug(current.stringify());
+        }
+        asc::translation_unit unit;
+        asc::ast_builder builder(tokens.begin(), streaming, experimental);
+        // used modules are compiled as soon as their use statement is parsed, so the types they export are known to the rest of the file
+        builder.use_module = [&ctx, &m](const std::string& path, std::unordered_set<asc::lexeme_id>& type_names)
+        {
+            asc::module* used = asc::require_module(ctx, path, &m);
+            if (used == nullptr)
+                return false;
+            for (asc::interface_type& type : used->exports.types)
+                type_names.insert(asc::intern(used->exports.strings[type.name]));
+            return true;
+        };
+        if (builder.parse(unit) != asc::STATE_FOUND)
+            return -1;
+        asc::parser ps(ctx);
+        ps.mod = &m;
+        if (ps.declare(unit.statements) != asc::STATE_FOUND)
+            return -1;
+        for (asc::statement_node* statement : unit.statements)
+        {
+            asc::debug("statement: " + statement->to_string());
+            if (ps.eval(statement) != asc::STATE_FOUND)
+                return -1;
+        }
+        ps.export_interface(unit.statements, m.exports);
+        if (!root) // a module used by another file is linked into its program, which has an entry point of its own
+            ps.as.entry.clear();
+        else if (ps.symbol_table_get(ps.as.entry) == nullptr)
         {
             asc::err("no entry point found in program");
             return -1;
         }
+        m.interface = filepath.substr(0, filepath.length() - 3) + ".asi";
+        if (!m.exports.write(m.interface))
+        {
+            asc::err("could not write interface file " + m.interface);
+            return -1;
+        }
         std::string asmfn = filepath.substr(0, filepath.length() - 3) + ".asm";
         std::ofstream os = std::ofstream(asmfn, std::ios::trunc);
         std::string constructed = ps.as.construct();
         os.write(constructed.c_str(), constructed.length());
         os.close();
-        is.close();
         asc::info("source code of \"" + filepath + "\" has been successfully converted to assembly");
-        if (SRC_ASSEMBLER == "nasm")
-            system(("nasm -fwin64 " + asmfn).c_str());
-        else
+        asc::debug(ps.memory.report());
+        if (ctx.assembler != "nasm")
         {
             asc::err("assembling \"" + filepath + "\" with unsupported assembler");
             return -1;
         }
-        asc::info("assembly code of \"" + asmfn + "\" has been successfully converted to object code");
-        OBJECT_FILES.push_back(filepath.substr(0, filepath.length() - 3) + ".obj");
+        // the object file is queued for linking now, so the link order is the order files were compiled in however the jobs finish
+        ctx.assembler_jobs.submit([asmfn]()
+        {
+            system(("nasm -fwin64 " + asmfn).c_str());
+            asc::info("assembly code of \"" + asmfn + "\" has been successfully converted to object code");
+        });
+        m.object = filepath.substr(0, filepath.length() - 3) + ".obj";
+        ctx.object_files.push_back(m.object);
         return 0;
     }
 
-    int experimental_compile(std::string& filepath)
+    int stable_compile(compilation_context& ctx, std::string& filepath, asc::module& m, bool root)
     {
-        return stable_compile(filepath);
+        return compile_file(ctx, filepath, m, false, root);
     }
 
-    int compile(std::string filepath)
+    int experimental_compile(compilation_context& ctx, std::string& filepath, asc::module& m, bool root)
     {
-        if (!has_option_set(args, cli_options::EXPERIMENTAL)) // if we're not in experimental mode
-            return stable_compile(filepath);
+        return compile_file(ctx, filepath, m, true, root);
+    }
+
+    static int reuse_build(compilation_context& ctx, module& m);
+
+    int compile(compilation_context& ctx, std::string filepath)
+    {
+        return require_module(ctx, filepath, nullptr) != nullptr ? 0 : -1;
+    }
+
+    /**
+     * @brief Compiles a file the first time it is required, later requirements get the module compiled then
+     * @param importer Module whose use statement requires the file, null for files given on the command line
+     * @return The compiled module, null if it could not be compiled
+     */
+    module* require_module(compilation_context& ctx, std::string filepath, module* importer)
+    {
+        module* m = ctx.modules.get(filepath);
+        if (importer != nullptr)
+            importer->import(m);
+        switch (m->state)
+        {
+            case module_states::COMPILED:
+                asc::debug("\"" + filepath + "\" is already compiled");
+                return m;
+            case module_states::FAILED:
+                return nullptr;
+            case module_states::COMPILING: // a use statement compiles its module before the file using it is done, so a cycle would never end
+                asc::err("\"" + filepath + "\" is used by a module it uses");
+                return nullptr;
+        }
+        m->state = module_states::COMPILING;
+        m->root = importer == nullptr;
+        asc::source_file source(filepath);
+        if (source.good())
+            m->hash = asc::content_hash(source.data(), source.length());
+        bool experimental = ctx.option(cli_options::EXPERIMENTAL);
+        m->rebuilt = ctx.builds.stale(*m, experimental);
+        if (m->rebuilt.empty() && reuse_build(ctx, *m) != 0)
+        {
+            m->state = module_states::FAILED;
+            return nullptr;
+        }
+        if (m->rebuilt.empty())
+        {
+            m->state = module_states::COMPILED;
+            return m;
+        }
+        int result;
+        if (!experimental) // if we're not in experimental mode
+            result = stable_compile(ctx, filepath, *m, m->root);
         else
-            return experimental_compile(filepath);
+            result = experimental_compile(ctx, filepath, *m, m->root);
+        m->state = result == 0 ? module_states::COMPILED : module_states::FAILED;
+        return result == 0 ? m : nullptr;
+    }
+
+    /**
+     * @brief Takes a module's last build instead of compiling it, once the modules it used are found unchanged.
+     * Those modules are required first, as compiling the module would, so they are built and linked before it.
+     * When one of them changed, the reason is left in the module's rebuilt field for it to be compiled after all.
+     */
+    static int reuse_build(compilation_context& ctx, module& m)
+    {
+        build_record* record = ctx.builds.find(m.path);
+        for (auto& use : record->uses)
+        {
+            module* used = require_module(ctx, use.first, &m);
+            if (used == nullptr)
+            {
+                asc::err("usage compilation of " + use.first + " failed");
+                return -1;
+            }
+            if (used->hash != use.second)
+            {
+                m.rebuilt = "used module " + used->filepath + " changed";
+                return 0;
+            }
+        }
+        if (!m.exports.read(record->interface)) // loaded straight from the file instead of compiling the module again
+        {
+            m.rebuilt = "interface file unreadable";
+            return 0;
+        }
+        m.interface = record->interface;
+        m.object = record->object;
+        ctx.object_files.push_back(m.object);
+        asc::debug("\"" + m.filepath + "\" is up to date, reusing " + m.object);
+        return 0;
     }
 
-    int visually_tokenize(std::string filepath)
+    int visually_tokenize(compilation_context& ctx, std::string filepath)
     {
         if (!asc::ends_with(filepath, ".as"))
         {
             asc::err(filepath + " is not A# source code");
             return -1;
         }
-        std::ifstream is = std::ifstream(filepath);
-        asc::syntax_node* current = asc::tokenize(is);
+        asc::source_file source(filepath);
+        if (!source.good())
+        {
+            asc::err("could not read " + filepath);
+            return -1;
+        }
+        asc::token_buffer tokens = asc::tokenize(ctx, source);
         asc::info(filepath + " tokenized: ");
-        for (; current != nullptr; current = current->next)
-            std::cout << current->stringify() << std::endl;
-        is.close();
+        for (asc::token_cursor current = tokens.begin(); !current.eof(); current = current.next())
+            std::cout << current.stringify() << std::endl;
+        return 0;
+    }
+
+    // Tokenizes a file repeatedly for at least a second, returns the throughput in tokens per second
+    double measure_tokenizer(std::string& filepath, const std::function<asc::token_buffer(const char*, size_t)>& tokenizer, int& tokens)
+    {
+        using clock = std::chrono::steady_clock;
+        int runs = 0;
+        clock::duration elapsed = clock::duration::zero();
+        for (; runs < 3 || elapsed < std::chrono::seconds(1); runs++)
+        {
+            auto start = clock::now();
+            asc::source_file source(filepath);
+            asc::token_buffer buffer = tokenizer(source.data(), source.length());
+            elapsed += clock::now() - start;
+            tokens = buffer.size();
+        }
+        return (double) tokens * runs / std::chrono::duration<double>(elapsed).count();
+    }
+
+    // Scans a file repeatedly for at least a second, returns the throughput in bytes per processor cycle
+    double measure_scanner(asc::source_file& source, asc::scan_level level)
+    {
+        unsigned long long cycles = 0;
+        size_t bytes = 0;
+        for (int runs = 0; runs < 3 || cycles < 1000000000ull; runs++) // roughly a second of cycles
+        {
+            unsigned long long start = asc::cycle_count();
+            asc::source_index index = asc::index_source(source.data(), source.length(), level);
+            cycles += asc::cycle_count() - start;
+            bytes += source.length();
+        }
+        return (double) bytes / cycles;
+    }
+
+    int benchmark_tokenizers(compilation_context& ctx, std::string filepath)
+    {
+        if (!asc::ends_with(filepath, ".as"))
+        {
+            asc::err(filepath + " is not A# source code");
+            return -1;
+        }
+        if (!asc::source_file(filepath).good())
+        {
+            asc::err("could not read " + filepath);
+            return -1;
+        }
+        int dfa_tokens = 0, regex_tokens = 0;
+        double dfa = measure_tokenizer(filepath, [](const char* data, size_t length) { return asc::tokenize(data, length); }, dfa_tokens);
+        double regex = measure_tokenizer(filepath, asc::tokenize_regex, regex_tokens);
+        asc::info(filepath + " benchmarked: ");
+        std::cout << "  dfa tokenizer:   " << dfa_tokens << " tokens, " << (long long) dfa << " tokens/s" << std::endl;
+        std::cout << "  regex tokenizer: " << regex_tokens << " tokens, " << (long long) regex << " tokens/s" << std::endl;
+        std::cout << "  speedup:         " << (regex > 0 ? dfa / regex : 0) << 'x' << std::endl;
+        if (asc::cycle_count() != 0)
+        {
+            asc::source_file source(filepath);
+            for (asc::scan_level level = asc::scan_levels::SCALAR; level <= asc::best_scan_level(); level++)
+                std::cout << "  " << asc::scan_levels::name(level) << " scanner: " << measure_scanner(source, level) << " bytes/cycle" << std::endl;
+        }
+        unsigned int threads = ctx.args.lex_threads;
+        if (threads > 1)
+        {
+            int parallel_tokens = 0;
+            double parallel = measure_tokenizer(filepath, [threads](const char* data, size_t length)
+                { return asc::tokenize_parallel(data, length, threads); }, parallel_tokens);
+            std::cout << "  dfa tokenizer (" << threads << " threads): " << parallel_tokens << " tokens, " <<
+                (long long) parallel << " tokens/s" << std::endl;
+        }
         return 0;
     }
 
-    int analyze_expressions(std::string filepath)
+    int analyze_expressions(compilation_context& ctx, std::string filepath)
     {
         if (!asc::ends_with(filepath, ".as"))
         {
             asc::err(filepath + " is not A# source code");
             return -1;
         }
-        std::ifstream is = std::ifstream(filepath);
-        asc::syntax_node* current = asc::tokenize(is);
-        asc::parser ps = asc::parser(current);
-        while (ps.parseable())
-            ps.eval_expression();
+        asc::source_file source(filepath);
+        if (!source.good())
+        {
+            asc::err("could not read " + filepath);
+            return -1;
+        }
+        asc::token_buffer tokens = asc::tokenize(ctx, source);
+        asc::ast_builder builder(tokens.begin());
+        asc::parser ps(ctx);
+        while (builder.parseable())
+        {
+            asc::expression_node* expression = nullptr;
+            asc::evaluation_state state = builder.parse_expression(builder.current, expression);
+            if (state == asc::STATE_FOUND)
+                state = ps.eval_expression(expression);
+            delete expression;
+            if (state != asc::STATE_FOUND)
+                return -1;
+        }
+        return 0;
+    }
+
+    int dump_syntax_tree(compilation_context& ctx, std::string filepath)
+    {
+        if (!asc::ends_with(filepath, ".as"))
+        {
+            asc::err(filepath + " is not A# source code");
+            return -1;
+        }
+        asc::source_file source(filepath);
+        if (!source.good())
+        {
+            asc::err("could not read " + filepath);
+            return -1;
+        }
+        asc::token_buffer tokens = asc::tokenize(ctx, source);
+        asc::translation_unit unit;
+        asc::ast_builder builder(tokens.begin(), false, ctx.option(asc::cli_options::EXPERIMENTAL));
+        if (builder.parse(unit) != asc::STATE_FOUND)
+            return -1;
+        asc::info(filepath + " parsed: ");
+        std::cout << unit.dump();
         return 0;
     }
 }
\ No newline at end of file
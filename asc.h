@@ -2,14 +2,19 @@
 #define ASC_H
 
 #include "cli.h"
+#include "module.h"
+#include "context.h"
 
 namespace asc
 {
-    extern asc::arg_result args;
-
-    int compile(std::string filepath);
-    int visually_tokenize(std::string filepath);
-    int analyze_expressions(std::string filepath);
+    int compile(compilation_context& ctx, std::string filepath);
+    module* require_module(compilation_context& ctx, std::string filepath, module* importer);
+    void finish_assembling(compilation_context& ctx);
+    void summarize_build(compilation_context& ctx);
+    int visually_tokenize(compilation_context& ctx, std::string filepath);
+    int analyze_expressions(compilation_context& ctx, std::string filepath);
+    int dump_syntax_tree(compilation_context& ctx, std::string filepath);
+    int benchmark_tokenizers(compilation_context& ctx, std::string filepath);
 }
 
 #endif
\ No newline at end of file
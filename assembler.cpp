@@ -3,11 +3,11 @@
 
 namespace asc
 {   
-    std::vector<std::string> ARG_REGISTER_SEQUENCE = {
+    const std::vector<std::string> ARG_REGISTER_SEQUENCE = {
         "rcx", "rdx", "r8", "r9"
     };
 
-    std::vector<std::string> FP_ARG_REGISTER_SEQUENCE = {
+    const std::vector<std::string> FP_ARG_REGISTER_SEQUENCE = {
         "xmm0", "xmm1", "xmm2", "xmm3"
     };
 
@@ -146,6 +146,12 @@ namespace asc
         return *this;
     }
 
+    assembler& assembler::global(std::string identifier)
+    {
+        glob.insert(identifier);
+        return *this;
+    }
+
     asc::subroutine*& assembler::sr(std::string& name, subroutine* parent)
     {
         asc::subroutine*& sr = subroutines[name];
@@ -214,7 +220,10 @@ namespace asc
         if (ext.size() != 0 || data.length() != 0 || bss.length() != 0)
             f += '\n';
         f += "section .text";
-        f += "\nglobal " + entry;
+        if (!entry.empty())
+            f += "\nglobal " + entry;
+        for (auto& g : glob)
+            f += "\nglobal " + g;
         for (std::pair<std::string, asc::subroutine*> subroutine : subroutines)
             f += '\n' + subroutine.first + ':' + subroutine.second->construct();
         return f;
@@ -14,8 +14,8 @@ namespace asc
 {
     typedef std::string register_resolvable;
 
-    extern std::vector<std::string> ARG_REGISTER_SEQUENCE;
-    extern std::vector<std::string> FP_ARG_REGISTER_SEQUENCE;
+    extern const std::vector<std::string> ARG_REGISTER_SEQUENCE;
+    extern const std::vector<std::string> FP_ARG_REGISTER_SEQUENCE;
 
     register_resolvable resolve_register(register_resolvable& identifier, int size);
     register_resolvable resolve_register(register_resolvable&& identifier, int size);
@@ -45,6 +45,7 @@ namespace asc
         std::string data;
         std::string bss;
         std::set<std::string> ext;
+        std::set<std::string> glob;
         std::map<std::string, subroutine*> subroutines;
     public:
         std::string entry;
@@ -60,6 +61,7 @@ namespace asc
         assembler& release(std::string& subroutine);
         assembler& release(std::string&& subroutine);
         assembler& external(std::string identifier);
+        assembler& global(std::string identifier);
         asc::subroutine*& sr(std::string& name, subroutine* parent);
         asc::subroutine*& sr(std::string& name);
         asc::subroutine*& sr(std::string&& name);
@@ -0,0 +1,338 @@
+#include "ast.h"
+#include "util.h"
+
+namespace asc
+{
+    namespace node_kinds
+    {
+        std::string name(node_kind kind)
+        {
+            switch (kind)
+            {
+                case USE: return "USE";
+                case FUNCTION: return "FUNCTION";
+                case VARIABLE: return "VARIABLE";
+                case TYPE: return "TYPE";
+                case OBJECT: return "OBJECT";
+                case NAMESPACE: return "NAMESPACE";
+                case RETURN: return "RETURN";
+                case DELETE_STATEMENT: return "DELETE_STATEMENT";
+                case IF: return "IF";
+                case WHILE: return "WHILE";
+                case EXPRESSION: return "EXPRESSION";
+                case LITERAL: return "LITERAL";
+                case NAME: return "NAME";
+                case TYPE_NAME: return "TYPE_NAME";
+                case OPERATION: return "OPERATION";
+                case CALL: return "CALL";
+                default: return "UNNAMED_NODE_KIND_" + std::to_string(kind);
+            }
+        }
+    }
+
+    static std::string visibility_prefix(visibility vis)
+    {
+        return vis == visibilities::INVALID || vis == visibilities::LOCAL ? "" : to_lowercase(visibilities::name(vis)) + ' ';
+    }
+
+    static std::string name_of(lexeme_id id)
+    {
+        return id != INVALID_LEXEME ? lexeme(id) : "<none>";
+    }
+
+    std::string type_expression::to_string() const
+    {
+        std::string str;
+        for (specifier s : specifiers)
+            str += to_lowercase(specifiers::name(s)) + ' ';
+        if (signed_specified)
+            str += "signed ";
+        str += name_of(name);
+        for (int i = 0; i < pointer_level; i++)
+            str += '*';
+        return str;
+    }
+
+    /* class expression_node */
+
+    expression_node::expression_node(node_kind kind, lexeme_id value, int line)
+    {
+        this->kind = kind;
+        this->value = value;
+        this->oper = operators::NONE;
+        this->line = line;
+    }
+
+    std::string expression_node::to_string()
+    {
+        switch (kind)
+        {
+            case node_kinds::TYPE_NAME: return "type " + type.to_string();
+            case node_kinds::CALL: return "call " + lexeme(value);
+            case node_kinds::OPERATION:
+            {
+                std::string str = "operator " + lexeme(value);
+                if (oper != operators::NONE && OPERATOR_TABLE[oper].operands == 1)
+                    str += OPERATOR_TABLE[oper].fix == SUFFIX_OPERATOR ? " (suffix)" : " (prefix)";
+                return str;
+            }
+            default: return lexeme(value);
+        }
+    }
+
+    // Frees the tree below the node without recursing, each node is emptied of its children before it is deleted
+    expression_node::~expression_node()
+    {
+        std::vector<expression_node*> pending;
+        pending.swap(children);
+        while (!pending.empty())
+        {
+            expression_node* node = pending.back();
+            pending.pop_back();
+            pending.insert(pending.end(), node->children.begin(), node->children.end());
+            node->children.clear();
+            delete node;
+        }
+    }
+
+    /* class statement_node */
+
+    statement_node::statement_node(node_kind kind, int line)
+    {
+        this->kind = kind;
+        this->line = line;
+    }
+
+    statement_node::~statement_node() {}
+
+    void delete_statements(statement_list& statements)
+    {
+        for (statement_node* statement : statements)
+            delete statement;
+        statements.clear();
+    }
+
+    /* class function_node */
+
+    function_node::function_node(int line): statement_node(node_kinds::FUNCTION, line)
+    {
+        this->vis = visibilities::PRIVATE;
+        this->name = INVALID_LEXEME;
+        this->constructor = false;
+        this->use_declaration = false;
+    }
+
+    std::string function_node::to_string()
+    {
+        std::string str = std::string(use_declaration ? "declared " : "") + (constructor ? "constructor " : "function ") +
+            visibility_prefix(vis) + (constructor ? "" : type.to_string() + ' ') + lexeme(name) + '(';
+        for (size_t i = 0; i < parameters.size(); i++)
+        {
+            if (i != 0)
+                str += ", ";
+            str += parameters[i].type.to_string();
+            if (parameters[i].name != INVALID_LEXEME)
+                str += ' ' + lexeme(parameters[i].name);
+        }
+        return str + ')';
+    }
+
+    function_node::~function_node()
+    {
+        delete_statements(body);
+    }
+
+    /* class use_node */
+
+    use_node::use_node(int line): statement_node(node_kinds::USE, line)
+    {
+        this->path = INVALID_LEXEME;
+        this->declaration = nullptr;
+    }
+
+    std::string use_node::to_string()
+    {
+        return declaration != nullptr ? "use" : "use " + name_of(path);
+    }
+
+    use_node::~use_node()
+    {
+        delete declaration;
+    }
+
+    /* class variable_node */
+
+    variable_node::variable_node(int line): statement_node(node_kinds::VARIABLE, line)
+    {
+        this->vis = visibilities::PRIVATE;
+        this->name = INVALID_LEXEME;
+        this->expression = nullptr;
+    }
+
+    std::string variable_node::to_string()
+    {
+        return "variable " + visibility_prefix(vis) + type.to_string() + ' ' + lexeme(name);
+    }
+
+    variable_node::~variable_node()
+    {
+        delete expression;
+    }
+
+    /* class type_node */
+
+    type_node::type_node(int line): statement_node(node_kinds::TYPE, line)
+    {
+        this->vis = visibilities::PRIVATE;
+        this->name = INVALID_LEXEME;
+    }
+
+    std::string type_node::to_string()
+    {
+        return "type " + visibility_prefix(vis) + lexeme(name);
+    }
+
+    /* class block_node */
+
+    block_node::block_node(node_kind kind, int line): statement_node(kind, line)
+    {
+        this->vis = visibilities::PRIVATE;
+        this->name = INVALID_LEXEME;
+        this->condition = nullptr;
+    }
+
+    std::string block_node::to_string()
+    {
+        switch (kind)
+        {
+            case node_kinds::OBJECT: return "object " + visibility_prefix(vis) + lexeme(name);
+            case node_kinds::NAMESPACE: return "namespace " + lexeme(name);
+            case node_kinds::IF: return "if";
+            case node_kinds::WHILE: return "while";
+            default: return to_lowercase(node_kinds::name(kind));
+        }
+    }
+
+    block_node::~block_node()
+    {
+        delete condition;
+        delete_statements(body);
+    }
+
+    /* class expression_statement */
+
+    expression_statement::expression_statement(node_kind kind, int line): statement_node(kind, line)
+    {
+        this->expression = nullptr;
+    }
+
+    std::string expression_statement::to_string()
+    {
+        switch (kind)
+        {
+            case node_kinds::RETURN: return "return";
+            case node_kinds::DELETE_STATEMENT: return "delete";
+            default: return "expression";
+        }
+    }
+
+    expression_statement::~expression_statement()
+    {
+        delete expression;
+    }
+
+    /* class translation_unit */
+
+    static void dump_line(std::string& out, int depth, const std::string& str, int line)
+    {
+        out.append(depth * 2, ' ');
+        out += str;
+        if (line != -1)
+            out += " (line " + std::to_string(line) + ')';
+        out += '\n';
+    }
+
+    static void dump_expression(std::string& out, int depth, expression_node* node)
+    {
+        std::vector<std::pair<expression_node*, int>> pending = { { node, depth } };
+        while (!pending.empty())
+        {
+            std::pair<expression_node*, int> next = pending.back();
+            pending.pop_back();
+            dump_line(out, next.second, next.first->to_string(), -1);
+            for (auto child = next.first->children.rbegin(); child != next.first->children.rend(); child++)
+                pending.push_back({ *child, next.second + 1 });
+        }
+    }
+
+    static void dump_statements(std::string& out, int depth, statement_list& statements);
+
+    static void dump_statement(std::string& out, int depth, statement_node* node)
+    {
+        dump_line(out, depth, node->to_string(), node->line);
+        switch (node->kind)
+        {
+            case node_kinds::USE:
+            {
+                use_node* use = static_cast<use_node*>(node);
+                if (use->declaration != nullptr)
+                    dump_statement(out, depth + 1, use->declaration);
+                break;
+            }
+            case node_kinds::FUNCTION:
+                dump_statements(out, depth + 1, static_cast<function_node*>(node)->body);
+                break;
+            case node_kinds::VARIABLE:
+            {
+                variable_node* variable = static_cast<variable_node*>(node);
+                if (variable->expression != nullptr)
+                    dump_expression(out, depth + 1, variable->expression);
+                break;
+            }
+            case node_kinds::TYPE:
+                for (parameter_declaration& field : static_cast<type_node*>(node)->fields)
+                    dump_line(out, depth + 1, "field " + field.type.to_string() + ' ' + lexeme(field.name), field.line);
+                break;
+            case node_kinds::OBJECT:
+            case node_kinds::NAMESPACE:
+            case node_kinds::IF:
+            case node_kinds::WHILE:
+            {
+                block_node* block = static_cast<block_node*>(node);
+                if (block->condition != nullptr)
+                {
+                    dump_line(out, depth + 1, "condition", -1);
+                    dump_expression(out, depth + 2, block->condition);
+                }
+                dump_statements(out, depth + 1, block->body);
+                break;
+            }
+            default:
+            {
+                expression_statement* statement = static_cast<expression_statement*>(node);
+                if (statement->expression != nullptr)
+                    dump_expression(out, depth + 1, statement->expression);
+                break;
+            }
+        }
+    }
+
+    static void dump_statements(std::string& out, int depth, statement_list& statements)
+    {
+        for (statement_node* statement : statements)
+            dump_statement(out, depth, statement);
+    }
+
+    // Renders the tree one node per line, children indented below their parent
+    std::string translation_unit::dump()
+    {
+        std::string out;
+        dump_statements(out, 0, statements);
+        return out;
+    }
+
+    translation_unit::~translation_unit()
+    {
+        delete_statements(statements);
+    }
+}
\ No newline at end of file
@@ -0,0 +1,184 @@
+#ifndef AST_H
+#define AST_H
+
+#include <string>
+#include <vector>
+#include <set>
+
+#include "interner.h"
+#include "syntax.h"
+
+namespace asc
+{
+    typedef unsigned char evaluation_state;
+    const unsigned char STATE_NEUTRAL = 0;
+    const unsigned char STATE_FOUND = 1;
+    const unsigned char STATE_SYNTAX_ERROR = 2;
+
+    typedef unsigned char node_kind;
+    namespace node_kinds
+    {
+        // statements
+        const node_kind USE = 0x00;
+        const node_kind FUNCTION = 0x01;
+        const node_kind VARIABLE = 0x02;
+        const node_kind TYPE = 0x03;
+        const node_kind OBJECT = 0x04;
+        const node_kind NAMESPACE = 0x05;
+        const node_kind RETURN = 0x06;
+        const node_kind DELETE_STATEMENT = 0x07;
+        const node_kind IF = 0x08;
+        const node_kind WHILE = 0x09;
+        const node_kind EXPRESSION = 0x0A;
+
+        // expressions
+        const node_kind LITERAL = 0x0B;
+        const node_kind NAME = 0x0C;
+        const node_kind TYPE_NAME = 0x0D;
+        const node_kind OPERATION = 0x0E;
+        const node_kind CALL = 0x0F;
+
+        std::string name(node_kind kind);
+    }
+
+    // type as it is written, resolved to a fully qualified type once the symbols it names exist
+    typedef struct type_expression
+    {
+        lexeme_id name = INVALID_LEXEME; // prefixed with 'u' when unsigned, then 's' or 'l' when short or long
+        bool signed_specified = false;
+        int pointer_level = 0;
+        std::set<specifier> specifiers;
+        int line = -1;
+
+        std::string to_string() const;
+    } type_expression;
+
+    class expression_node
+    {
+    public:
+        node_kind kind;
+        lexeme_id value; // literal, name, operator or function called
+        operator_id oper; // operator of an operation, tells prefix and infix variants apart, NONE for other nodes
+        type_expression type; // type of a type name
+        std::vector<expression_node*> children; // operands of an operation or arguments of a call, in source order
+        int line;
+
+        expression_node(node_kind kind, lexeme_id value, int line);
+        std::string to_string();
+        ~expression_node();
+    };
+
+    class statement_node
+    {
+    public:
+        node_kind kind;
+        int line;
+    protected:
+        statement_node(node_kind kind, int line);
+    public:
+        virtual std::string to_string() = 0;
+        virtual ~statement_node();
+    };
+
+    typedef std::vector<statement_node*> statement_list;
+
+    typedef struct parameter_declaration
+    {
+        type_expression type;
+        lexeme_id name; // INVALID_LEXEME for nameless parameters of functions declared by use statements
+        int line;
+    } parameter_declaration;
+
+    class function_node: public statement_node
+    {
+    public:
+        visibility vis;
+        type_expression type; // return type, unused for constructors
+        lexeme_id name;
+        bool constructor;
+        bool use_declaration; // declared by a use statement, has no body
+        std::vector<parameter_declaration> parameters;
+        statement_list body;
+
+        function_node(int line);
+        std::string to_string() override;
+        ~function_node();
+    };
+
+    class use_node: public statement_node
+    {
+    public:
+        lexeme_id path; // file to compile, INVALID_LEXEME when a function is declared
+        function_node* declaration;
+
+        use_node(int line);
+        std::string to_string() override;
+        ~use_node();
+    };
+
+    class variable_node: public statement_node
+    {
+    public:
+        visibility vis;
+        type_expression type;
+        lexeme_id name;
+        expression_node* expression; // the declaration as an expression starting at the name, such as 'a = 1'
+
+        variable_node(int line);
+        std::string to_string() override;
+        ~variable_node();
+    };
+
+    class type_node: public statement_node
+    {
+    public:
+        visibility vis;
+        lexeme_id name;
+        std::vector<parameter_declaration> fields;
+
+        type_node(int line);
+        std::string to_string() override;
+    };
+
+    // object, namespace, if and while statements, which hold a block of statements
+    class block_node: public statement_node
+    {
+    public:
+        visibility vis; // visibility of an object
+        lexeme_id name; // name of an object or namespace
+        expression_node* condition; // condition of an if statement or while loop
+        statement_list body;
+
+        block_node(node_kind kind, int line);
+        std::string to_string() override;
+        ~block_node();
+    };
+
+    // return, delete and expression statements
+    class expression_statement: public statement_node
+    {
+    public:
+        expression_node* expression; // null for an empty expression
+
+        expression_statement(node_kind kind, int line);
+        std::string to_string() override;
+        ~expression_statement();
+    };
+
+    // Top-level statements of a source file
+    class translation_unit
+    {
+    public:
+        statement_list statements;
+
+        translation_unit() = default;
+        translation_unit(const translation_unit&) = delete;
+        translation_unit& operator=(const translation_unit&) = delete;
+        std::string dump();
+        ~translation_unit();
+    };
+
+    void delete_statements(statement_list& statements);
+}
+
+#endif
\ No newline at end of file
@@ -0,0 +1,154 @@
+#include <fstream>
+#include <sstream>
+
+#include "build.h"
+#include "logger.h"
+
+namespace asc
+{
+    const char BUILD_MAGIC[] = "asc build";
+
+    /*
+     * Layout of the database, one entry per line:
+     * "asc build <version>", then "link <object>" for each object file of the last link, then for each module
+     * "module <hash> <experimental> <root> <path>", "object <path>", "interface <path>" and "use <hash> <path>"
+     * for each module it used, by the path it was first required by. Paths come last on their line, so they may hold spaces.
+     */
+
+    // Rest of a line after the fields read from it, without the space separating them
+    static std::string rest(std::istringstream& is)
+    {
+        std::string r;
+        std::getline(is >> std::ws, r);
+        return r;
+    }
+
+    static bool file_exists(const std::string& path)
+    {
+        return std::ifstream(path).good();
+    }
+
+    // Loads the database at the path, a missing or damaged one leaves every module to be built
+    void build_database::open(const std::string& path)
+    {
+        this->path = path;
+        std::ifstream is(path);
+        if (!is.good())
+            return;
+        std::string line;
+        unsigned int version = 0;
+        if (!std::getline(is, line) || line.compare(0, sizeof(BUILD_MAGIC) - 1, BUILD_MAGIC) != 0 ||
+            !(std::istringstream(line.substr(sizeof(BUILD_MAGIC) - 1)) >> version) || version != BUILD_VERSION)
+        {
+            asc::debug("build database " + path + " was written by another version, rebuilding everything");
+            return;
+        }
+        build_record* record = nullptr;
+        while (std::getline(is, line))
+        {
+            std::istringstream ls(line);
+            std::string kind;
+            ls >> kind;
+            if (kind == "link")
+                linked.push_back(rest(ls));
+            else if (kind == "module")
+            {
+                build_record r;
+                if (!(ls >> std::hex >> r.hash >> std::dec >> r.experimental >> r.root))
+                    break;
+                r.path = rest(ls);
+                record = &(records[r.path] = std::move(r));
+            }
+            else if (record == nullptr)
+                break;
+            else if (kind == "object")
+                record->object = rest(ls);
+            else if (kind == "interface")
+                record->interface = rest(ls);
+            else if (kind == "use")
+            {
+                unsigned long long hash;
+                if (!(ls >> std::hex >> hash))
+                    break;
+                record->uses.push_back({ rest(ls), hash });
+            }
+            else
+                break;
+        }
+        if (!is.eof())
+        {
+            asc::warn("build database " + path + " is damaged, rebuilding everything");
+            records.clear();
+            linked.clear();
+        }
+    }
+
+    build_record* build_database::find(const std::string& module_path)
+    {
+        auto it = records.find(module_path);
+        return it != records.end() ? &it->second : nullptr;
+    }
+
+    /**
+     * @brief Tells why a module has to be built again, leaving the modules it used to be checked by the caller
+     * @return The reason, empty if the module's last build is still good as far as the module itself goes
+     */
+    std::string build_database::stale(module& m, bool experimental)
+    {
+        build_record* record = find(m.path);
+        if (record == nullptr)
+            return "not built before";
+        if (record->hash != m.hash)
+            return "source changed";
+        if (record->experimental != experimental)
+            return experimental ? "compiling experimentally" : "no longer compiling experimentally";
+        if (record->root != m.root)
+            return m.root ? "given on the command line" : "no longer given on the command line";
+        if (!file_exists(record->object))
+            return "object file missing";
+        if (!file_exists(record->interface))
+            return "interface file missing";
+        return "";
+    }
+
+    // Tells why the program has to be linked again, empty if its objects are the ones it was last linked from
+    std::string build_database::relink_reason(module_registry& registry, const std::vector<std::string>& objects, const std::string& output)
+    {
+        for (module* m : registry.modules)
+        {
+            if (!m->rebuilt.empty())
+                return "modules were rebuilt";
+        }
+        if (objects != linked)
+            return "object files changed";
+        if (!file_exists(output) && !file_exists(output + ".exe"))
+            return "program missing";
+        return "";
+    }
+
+    // Records how every compiled module was built and which objects the program was linked from
+    bool build_database::store(module_registry& registry, bool experimental, const std::vector<std::string>& objects)
+    {
+        std::ofstream os(path, std::ios::trunc);
+        if (!os.good())
+        {
+            asc::warn("could not write build database " + path);
+            return false;
+        }
+        os << BUILD_MAGIC << ' ' << BUILD_VERSION << '\n';
+        for (const std::string& object : objects)
+            os << "link " << object << '\n';
+        for (module* m : registry.modules)
+        {
+            if (m->state != module_states::COMPILED)
+                continue;
+            os << "module " << std::hex << m->hash << std::dec << ' ' << experimental << ' ' << m->root << ' ' << m->path << '\n';
+            os << "object " << m->object << '\n';
+            os << "interface " << m->interface << '\n';
+            for (module* used : m->imports)
+                os << "use " << std::hex << used->hash << std::dec << ' ' << used->filepath << '\n';
+        }
+        linked = objects;
+        return os.good();
+    }
+}
\ No newline at end of file
@@ -0,0 +1,49 @@
+#ifndef BUILD_H
+#define BUILD_H
+
+#include <string>
+#include <vector>
+#include <unordered_map>
+
+#include "module.h"
+
+namespace asc
+{
+    const unsigned int BUILD_VERSION = 2; // raise whenever the compiler starts generating different code, rebuilds every module
+
+    // A module as it was last built
+    typedef struct build_record
+    {
+        std::string path;
+        unsigned long long hash; // content_hash of the source it was built from
+        bool experimental; // built with the experimental compiler
+        bool root; // built as a file given on the command line, with an entry point
+        std::string object;
+        std::string interface;
+        std::vector<std::pair<std::string, unsigned long long>> uses; // path and hash of each module it used
+    } build_record;
+
+    /**
+     * @brief Text file recording how each module of a program was last built, so an unchanged module is not built again.
+     * A module is up to date when its source, the way it is compiled and the source of every module it uses are
+     * the same as they were recorded, and its object and interface files are still there.
+     */
+    class build_database
+    {
+    private:
+        std::string path;
+        std::unordered_map<std::string, build_record> records;
+        std::vector<std::string> linked; // object files of the last link, in link order
+    public:
+        build_database() = default;
+        build_database(const build_database&) = delete;
+        build_database& operator=(const build_database&) = delete;
+        void open(const std::string& path);
+        build_record* find(const std::string& module_path);
+        std::string stale(module& m, bool experimental);
+        std::string relink_reason(module_registry& registry, const std::vector<std::string>& objects, const std::string& output);
+        bool store(module_registry& registry, bool experimental, const std::vector<std::string>& objects);
+    };
+}
+
+#endif
\ No newline at end of file
@@ -0,0 +1,785 @@
+#include "builder.h"
+#include "symbol.h"
+
+namespace asc
+{
+    static bool check_eof(token_cursor& node, bool silence = false)
+    {
+        if (node.eof())
+        {
+            if (!silence)
+                asc::err("unexpected end of file");
+            return true;
+        }
+        return false;
+    }
+
+    // Holds a level of nesting for as long as it is in scope, so every way out of a parse method gives it back
+    typedef struct nesting_level
+    {
+        int& depth;
+
+        nesting_level(int& depth): depth(depth)
+        {
+            depth++;
+        }
+
+        ~nesting_level()
+        {
+            depth--;
+        }
+    } nesting_level;
+
+    static evaluation_state nested_too_deeply(token_cursor& lcurrent, const std::string& message)
+    {
+        if (lcurrent.eof())
+            asc::err(message + " too deeply");
+        else
+            asc::err(message + " too deeply", lcurrent.line());
+        return STATE_SYNTAX_ERROR;
+    }
+
+    // Moves past a token which has to come next, reporting an error if it does not
+    static evaluation_state expect(token_cursor& lcurrent, const std::string& value)
+    {
+        if (lcurrent != value)
+        {
+            if (lcurrent.eof())
+                asc::err("unexpected end of expression");
+            else
+                asc::err("expected '" + value + "' but found '" + lcurrent.value() + '\'', lcurrent.line());
+            return STATE_SYNTAX_ERROR;
+        }
+        lcurrent = lcurrent.next();
+        return STATE_FOUND;
+    }
+
+    ast_builder::ast_builder(token_cursor root, bool streaming, bool experimental)
+    {
+        this->current = root;
+        this->scope = nullptr;
+        this->streaming = streaming;
+        this->experimental = experimental;
+        this->depth = 0;
+        for (const standard_type& type : STANDARD_TYPES)
+            type_names.insert(intern(type.name));
+    }
+
+    bool ast_builder::parseable()
+    {
+        return !current.eof();
+    }
+
+    /**
+     * @brief Parses every statement left in the token stream
+     * @param unit Translation unit the statements are added to
+     * @return STATE_FOUND once the end of the file is reached, STATE_SYNTAX_ERROR if a statement could not be parsed
+     */
+    evaluation_state ast_builder::parse(translation_unit& unit)
+    {
+        while (parseable())
+        {
+            statement_node* statement = nullptr;
+            evaluation_state state = parse_statement(current, statement);
+            if (state == STATE_NEUTRAL)
+            {
+                asc::err("unknown statement", current.line());
+                return STATE_SYNTAX_ERROR;
+            }
+            if (state == STATE_SYNTAX_ERROR)
+                return STATE_SYNTAX_ERROR;
+            unit.statements.push_back(statement);
+        }
+        return STATE_FOUND;
+    }
+
+    // Parses statements up to the right brace closing a block, block is the node the statements belong to
+    evaluation_state ast_builder::parse_block(token_cursor& lcurrent, statement_list& body, statement_node* block)
+    {
+        nesting_level level(depth);
+        if (depth > MAX_NESTING_DEPTH)
+            return nested_too_deeply(lcurrent, "blocks are nested");
+        statement_node* outer = scope;
+        scope = block;
+        while (true)
+        {
+            if (check_eof(lcurrent))
+                return STATE_SYNTAX_ERROR;
+            if (lcurrent == lexemes::RIGHT_BRACE)
+                break;
+            statement_node* statement = nullptr;
+            evaluation_state state = parse_statement(lcurrent, statement);
+            if (state == STATE_NEUTRAL)
+            {
+                asc::err("unknown statement", lcurrent.line());
+                return STATE_SYNTAX_ERROR;
+            }
+            if (state == STATE_SYNTAX_ERROR)
+                return STATE_SYNTAX_ERROR;
+            body.push_back(statement);
+        }
+        lcurrent = lcurrent.next(); // move past the right brace
+        scope = outer;
+        return STATE_FOUND;
+    }
+
+    /**
+     * @brief Parses a statement, chosen from its first tokens.
+     * Keywords pick their statement directly, otherwise the visibility and type a declaration starts with are
+     * read once and the token after them tells functions, variables and expressions apart.
+     */
+    evaluation_state ast_builder::parse_statement(token_cursor& lcurrent, statement_node*& result)
+    {
+        if (streaming && lcurrent.buffer != nullptr)
+            lcurrent.buffer->release(lcurrent.index); // nothing before a statement is read again
+        switch (lcurrent.id())
+        {
+            case lexemes::RIGHT_BRACE:
+                asc::err("attempting to scope out of the global scope", lcurrent.line());
+                return STATE_SYNTAX_ERROR;
+            case lexemes::USE:
+                return parse_use(lcurrent, result);
+            case lexemes::RETURN:
+                return parse_expression_statement(lcurrent, result, node_kinds::RETURN);
+            case lexemes::DELETE_STATEMENT:
+                return parse_expression_statement(lcurrent, result, node_kinds::DELETE_STATEMENT);
+            case lexemes::IF:
+            case lexemes::WHILE:
+                if (experimental)
+                    return parse_conditional(lcurrent, result);
+                break;
+            case lexemes::NAMESPACE:
+                if (experimental)
+                    return parse_namespace(lcurrent, result);
+                break;
+        }
+        statement_head head;
+        read_head(lcurrent, head);
+        if (head.type_state == STATE_SYNTAX_ERROR)
+            return STATE_SYNTAX_ERROR;
+        if (head.start == lexemes::TYPE)
+            return parse_type_construct(lcurrent, head, result);
+        if (head.start == lexemes::OBJECT)
+            return parse_object_construct(lcurrent, head, result);
+        token_cursor after = head.type_state == STATE_FOUND && !head.name.eof() ? head.name.next() : token_cursor();
+        if (head.constructor || after == lexemes::LEFT_PARENTHESIS)
+        {
+            function_node* function = nullptr;
+            evaluation_state state = parse_function(lcurrent, head, function, false);
+            result = function;
+            return state;
+        }
+        if (after == lexemes::ASSIGNMENT || after == lexemes::SEMICOLON || after == lexemes::ALLOCATION)
+            return parse_var_declaration(lcurrent, head, result);
+        return parse_expression_statement(lcurrent, result, node_kinds::EXPRESSION);
+    }
+
+    // Reads the visibility and type a declaration starts with, whichever of them are there
+    void ast_builder::read_head(token_cursor lcurrent, statement_head& head)
+    {
+        head.vis = visibilities::value_of(asc::to_uppercase(lcurrent.value()));
+        head.start = head.vis != visibilities::INVALID ? lcurrent.next() : lcurrent;
+        head.name = head.start;
+        if (head.start.eof())
+            return;
+        block_node* obj = scope != nullptr && scope->kind == node_kinds::OBJECT ? static_cast<block_node*>(scope) : nullptr;
+        head.constructor = obj != nullptr && (head.start == lexemes::CONSTRUCTOR || head.start == "_C" + lexeme(obj->name));
+        if (!head.constructor)
+            head.type_state = parse_type(head.name, head.type);
+    }
+
+    evaluation_state ast_builder::parse_use(token_cursor& lcurrent, statement_node*& result)
+    {
+        token_cursor slcurrent = lcurrent.next();
+        if (check_eof(slcurrent, true))
+            return STATE_NEUTRAL;
+        use_node* node = new use_node(slcurrent.line());
+        if (slcurrent.type() == syntax_types::KEYWORD) // eventual handling for native use statements
+        {
+            if (slcurrent == lexemes::NATIVE)
+            {
+                asc::err("unimplemented feature: native use statements", slcurrent.line());
+                delete node;
+                return STATE_SYNTAX_ERROR;
+            }
+            statement_head head;
+            read_head(slcurrent, head);
+            evaluation_state header = head.type_state == STATE_SYNTAX_ERROR ? STATE_SYNTAX_ERROR :
+                parse_function(slcurrent, head, node->declaration, true);
+            if (header == STATE_NEUTRAL)
+                asc::err("function declaration is incomplete", slcurrent.line());
+            if (header != STATE_FOUND)
+            {
+                delete node;
+                return STATE_SYNTAX_ERROR;
+            }
+        }
+        else
+            node->path = slcurrent.id();
+        slcurrent = slcurrent.next(); // skip to semicolon
+        if (check_eof(slcurrent, true))
+        {
+            delete node;
+            return STATE_NEUTRAL;
+        }
+        if (slcurrent != lexemes::SEMICOLON)
+        {
+            asc::err("expected a semicolon", slcurrent.line());
+            delete node;
+            return STATE_SYNTAX_ERROR;
+        }
+        if (node->path != INVALID_LEXEME && use_module)
+        {
+            std::string path = lexeme(node->path);
+            asc::unwrap(path);
+            if (!use_module(path, type_names))
+            {
+                asc::err("usage compilation of " + path + " failed", node->line);
+                delete node;
+                return STATE_SYNTAX_ERROR;
+            }
+        }
+        lcurrent = slcurrent.next(); // go past semicolon
+        result = node;
+        return STATE_FOUND;
+    }
+
+    /**
+     * @brief Parses a function header and its body, or a function declared by a use statement, which ends at its right parenthesis
+     * @return STATE_NEUTRAL if the tokens are not a function header
+     */
+    evaluation_state ast_builder::parse_function(token_cursor& lcurrent, statement_head& head, function_node*& result, bool use_declaration)
+    {
+        if (!head.constructor && head.type_state != STATE_FOUND)
+            return STATE_NEUTRAL;
+        token_cursor slcurrent = head.name;
+        if (check_eof(slcurrent, true))
+            return STATE_NEUTRAL;
+        block_node* obj = head.constructor ? static_cast<block_node*>(scope) : nullptr;
+        bool constructor = head.constructor;
+        visibility vis = head.vis != visibilities::INVALID ? head.vis : visibilities::PRIVATE;
+        type_expression& type = head.type;
+        int line = slcurrent.line();
+        lexeme_id name = constructor ? intern("_C" + lexeme(obj->name)) : slcurrent.id();
+        slcurrent = slcurrent.next();
+        if (check_eof(slcurrent, true))
+            return STATE_NEUTRAL;
+        if (slcurrent != lexemes::LEFT_PARENTHESIS) // not a function, most likely a variable declaration
+            return STATE_NEUTRAL;
+        lcurrent = slcurrent;
+        function_node* node = new function_node(line);
+        node->vis = vis;
+        node->type = type;
+        node->name = name;
+        node->constructor = constructor;
+        node->use_declaration = use_declaration;
+        bool method = scope != nullptr && scope->kind == node_kinds::OBJECT;
+        for (int c = method && !constructor ? 2 : 1; true; c++) // methods take 'this' as their first argument
+        {
+            lcurrent = lcurrent.next(); // first, the argument type
+            if (check_eof(lcurrent) || lcurrent == lexemes::RIGHT_PARENTHESIS)
+                break;
+            parameter_declaration parameter;
+            parameter.line = lcurrent.line();
+            evaluation_state at_state = parse_type(lcurrent, parameter.type);
+            if (at_state == STATE_NEUTRAL)
+                asc::err("type specifier expected for argument " + std::to_string(c), parameter.line);
+            if (at_state != STATE_FOUND || check_eof(lcurrent))
+            {
+                delete node;
+                return STATE_SYNTAX_ERROR;
+            }
+            // second, the argument identifier
+            if (lcurrent == lexemes::COMMA || lcurrent == lexemes::RIGHT_PARENTHESIS) // nameless argument
+            {
+                if (!use_declaration)
+                {
+                    asc::err("nameless function arguments are not allowed", parameter.line);
+                    delete node;
+                    return STATE_SYNTAX_ERROR;
+                }
+                parameter.name = INVALID_LEXEME;
+                node->parameters.push_back(parameter);
+                if (lcurrent == lexemes::RIGHT_PARENTHESIS)
+                    break;
+                continue;
+            }
+            parameter.name = lcurrent.id();
+            parameter.line = lcurrent.line();
+            node->parameters.push_back(parameter);
+            lcurrent = lcurrent.next(); // lastly, what's next?
+            if (check_eof(lcurrent) || lcurrent == lexemes::RIGHT_PARENTHESIS)
+                break;
+            if (lcurrent != lexemes::COMMA)
+            {
+                asc::err("unexpected end to argument listing", lcurrent.line());
+                delete node;
+                return STATE_SYNTAX_ERROR;
+            }
+        }
+        if (lcurrent.eof())
+        {
+            delete node;
+            return STATE_SYNTAX_ERROR;
+        }
+        if (use_declaration) // declarations have no body, the use statement continues from the right parenthesis
+        {
+            result = node;
+            return STATE_FOUND;
+        }
+        lcurrent = lcurrent.next();
+        if (!check_eof(lcurrent) && lcurrent != lexemes::LEFT_BRACE)
+            asc::err("expected a left curly brace to start function", lcurrent.line());
+        if (lcurrent.eof() || lcurrent != lexemes::LEFT_BRACE)
+        {
+            delete node;
+            return STATE_SYNTAX_ERROR;
+        }
+        lcurrent = lcurrent.next(); // move into the function
+        if (parse_block(lcurrent, node->body, node) == STATE_SYNTAX_ERROR)
+        {
+            delete node;
+            return STATE_SYNTAX_ERROR;
+        }
+        result = node;
+        return STATE_FOUND;
+    }
+
+    evaluation_state ast_builder::parse_var_declaration(token_cursor& lcurrent, statement_head& head, statement_node*& result)
+    {
+        // only global and object variables are given a visibility
+        bool local = scope != nullptr && scope->kind != node_kinds::OBJECT;
+        if (local && head.vis != visibilities::INVALID && head.vis != visibilities::LOCAL)
+        {
+            asc::err("local variables cannot be given a visibility", lcurrent.line());
+            return STATE_SYNTAX_ERROR;
+        }
+        visibility vis = local ? visibilities::LOCAL : (head.vis != visibilities::INVALID ? head.vis : visibilities::PRIVATE);
+        type_expression& type = head.type;
+        token_cursor i_node = head.name; // the expression of the declaration starts at its identifier
+        variable_node* node = new variable_node(i_node.line());
+        node->vis = vis;
+        node->type = type;
+        node->name = i_node.id();
+        lcurrent = i_node;
+        evaluation_state state = parse_expression(lcurrent, node->expression);
+        if (state != STATE_FOUND)
+        {
+            delete node;
+            return STATE_SYNTAX_ERROR;
+        }
+        result = node;
+        return STATE_FOUND;
+    }
+
+    evaluation_state ast_builder::parse_type_construct(token_cursor& lcurrent, statement_head& head, statement_node*& result)
+    {
+        visibility vis = head.vis != visibilities::INVALID ? head.vis : visibilities::PRIVATE;
+        lcurrent = head.start;
+        if (check_eof(lcurrent = lcurrent.next())) // move forward to identifier
+            return STATE_SYNTAX_ERROR;
+        type_node* node = new type_node(lcurrent.line());
+        node->vis = vis;
+        node->name = lcurrent.id();
+        type_names.insert(node->name); // fields may point to the type itself
+        if (check_eof(lcurrent = lcurrent.next()))
+        {
+            delete node;
+            return STATE_SYNTAX_ERROR;
+        }
+        if (lcurrent == lexemes::EXTENDS)
+            asc::err("inheritance is not implemented yet", lcurrent.line());
+        else if (lcurrent != lexemes::LEFT_BRACE)
+            asc::err("type definition expected", lcurrent.line());
+        if (lcurrent != lexemes::LEFT_BRACE || check_eof(lcurrent = lcurrent.next())) // move past brace
+        {
+            delete node;
+            return STATE_SYNTAX_ERROR;
+        }
+        while (!check_eof(lcurrent) && lcurrent != lexemes::RIGHT_BRACE)
+        {
+            parameter_declaration field;
+            field.line = lcurrent.line();
+            evaluation_state t_state = parse_type(lcurrent, field.type);
+            if (t_state == STATE_NEUTRAL)
+                asc::err("type expected", field.line);
+            else if (t_state == STATE_FOUND && !lcurrent.eof() && lcurrent.type() != syntax_types::IDENTIFIER)
+            {
+                asc::err("identifier expected", lcurrent.line());
+                t_state = STATE_SYNTAX_ERROR;
+            }
+            if (t_state != STATE_FOUND || check_eof(lcurrent))
+            {
+                delete node;
+                return STATE_SYNTAX_ERROR;
+            }
+            field.name = lcurrent.id();
+            field.line = lcurrent.line();
+            node->fields.push_back(field);
+            while (!check_eof(lcurrent = lcurrent.next()) && lcurrent != lexemes::SEMICOLON);
+            if (lcurrent.eof() || check_eof(lcurrent = lcurrent.next())) // skip semicolon
+            {
+                delete node;
+                return STATE_SYNTAX_ERROR;
+            }
+        }
+        if (lcurrent.eof())
+        {
+            delete node;
+            return STATE_SYNTAX_ERROR;
+        }
+        lcurrent = lcurrent.next();
+        result = node;
+        return STATE_FOUND;
+    }
+
+    evaluation_state ast_builder::parse_object_construct(token_cursor& lcurrent, statement_head& head, statement_node*& result)
+    {
+        visibility vis = head.vis != visibilities::INVALID ? head.vis : visibilities::PRIVATE;
+        lcurrent = head.start;
+        if (check_eof(lcurrent = lcurrent.next())) // move forward to identifier
+            return STATE_SYNTAX_ERROR;
+        block_node* node = new block_node(node_kinds::OBJECT, lcurrent.line());
+        node->vis = vis;
+        node->name = lcurrent.id();
+        type_names.insert(node->name);
+        if (check_eof(lcurrent = lcurrent.next()))
+        {
+            delete node;
+            return STATE_SYNTAX_ERROR;
+        }
+        if (lcurrent == lexemes::EXTENDS)
+            asc::err("inheritance is not implemented yet", lcurrent.line());
+        else if (lcurrent != lexemes::LEFT_BRACE)
+            asc::err("object definition expected", lcurrent.line());
+        if (lcurrent != lexemes::LEFT_BRACE || parse_block(lcurrent = lcurrent.next(), node->body, node) == STATE_SYNTAX_ERROR)
+        {
+            delete node;
+            return STATE_SYNTAX_ERROR;
+        }
+        result = node;
+        return STATE_FOUND;
+    }
+
+    evaluation_state ast_builder::parse_namespace(token_cursor& lcurrent, statement_node*& result)
+    {
+        if (lcurrent != lexemes::NAMESPACE) // not a namespace
+            return STATE_NEUTRAL;
+        if (check_eof(lcurrent = lcurrent.next()))
+            return STATE_SYNTAX_ERROR;
+        block_node* node = new block_node(node_kinds::NAMESPACE, lcurrent.line());
+        node->name = lcurrent.id();
+        if (!check_eof(lcurrent = lcurrent.next()) && lcurrent != lexemes::LEFT_BRACE)
+            asc::err("expected a left curly brace to start namespace", lcurrent.line());
+        // namespaces do not change the scope of the statements within them
+        if (lcurrent.eof() || lcurrent != lexemes::LEFT_BRACE ||
+            parse_block(lcurrent = lcurrent.next(), node->body, scope) == STATE_SYNTAX_ERROR)
+        {
+            delete node;
+            return STATE_SYNTAX_ERROR;
+        }
+        result = node;
+        return STATE_FOUND;
+    }
+
+    // Parses an if statement or while loop
+    evaluation_state ast_builder::parse_conditional(token_cursor& lcurrent, statement_node*& result)
+    {
+        if (lcurrent != lexemes::IF && lcurrent != lexemes::WHILE)
+            return STATE_NEUTRAL;
+        bool loop = lcurrent == lexemes::WHILE;
+        block_node* node = new block_node(loop ? node_kinds::WHILE : node_kinds::IF, lcurrent.line());
+        if (!check_eof(lcurrent = lcurrent.next()) && lcurrent != lexemes::LEFT_PARENTHESIS)
+            asc::err(loop ? "expected left parenthesis to start while condition" : "expected left parenthesis to start if statement", lcurrent.line());
+        if (lcurrent.eof() || lcurrent != lexemes::LEFT_PARENTHESIS)
+        {
+            delete node;
+            return STATE_SYNTAX_ERROR;
+        }
+        evaluation_state state = parse_expression(lcurrent = lcurrent.next(), node->condition, lexemes::RIGHT_PARENTHESIS);
+        if (state == STATE_NEUTRAL || (state == STATE_FOUND && node->condition == nullptr))
+            asc::err("expression expected", lcurrent.line());
+        if (state != STATE_FOUND || node->condition == nullptr)
+        {
+            delete node;
+            return STATE_SYNTAX_ERROR;
+        }
+        if (!check_eof(lcurrent) && lcurrent != lexemes::LEFT_BRACE)
+            asc::err(std::string("expected a left curly brace to start ") + (loop ? "while loop" : "if statement"), lcurrent.line());
+        if (lcurrent.eof() || lcurrent != lexemes::LEFT_BRACE || parse_block(lcurrent = lcurrent.next(), node->body, node) == STATE_SYNTAX_ERROR)
+        {
+            delete node;
+            return STATE_SYNTAX_ERROR;
+        }
+        result = node;
+        return STATE_FOUND;
+    }
+
+    // Parses a return, delete or expression statement, return and delete are followed by their expression
+    evaluation_state ast_builder::parse_expression_statement(token_cursor& lcurrent, statement_node*& result, node_kind kind)
+    {
+        int line = lcurrent.line();
+        token_cursor slcurrent = kind != node_kinds::EXPRESSION ? lcurrent.next() : lcurrent;
+        expression_node* expression = nullptr;
+        evaluation_state state = parse_expression(slcurrent, expression);
+        if (state != STATE_FOUND)
+            return state;
+        expression_statement* node = new expression_statement(kind, line);
+        node->expression = expression;
+        lcurrent = slcurrent;
+        result = node;
+        return STATE_FOUND;
+    }
+
+    /**
+     * @brief Parses an expression into a tree by precedence climbing, using the precedence and association of OPERATOR_TABLE
+     * @param lcurrent First token of the expression, moved past the terminator
+     * @param result Root of the expression, null if it is empty
+     * @param terminator Token ending the expression
+     * @return STATE_NEUTRAL if the file ended before the expression started
+     */
+    evaluation_state ast_builder::parse_expression(token_cursor& lcurrent, expression_node*& result, lexeme_id terminator)
+    {
+        if (lcurrent.eof())
+            return STATE_NEUTRAL;
+        result = nullptr;
+        if (lcurrent != terminator && parse_binary(lcurrent, LOWEST_PRECEDENCE, result) != STATE_FOUND)
+            return STATE_SYNTAX_ERROR;
+        if (lcurrent != terminator)
+        {
+            if (lcurrent.eof())
+                asc::err("unexpected end of expression");
+            else
+                asc::err("unexpected '" + lcurrent.value() + "' in expression", lcurrent.line());
+            delete result;
+            result = nullptr;
+            return STATE_SYNTAX_ERROR;
+        }
+        lcurrent = lcurrent.next(); // skip over the terminator
+        return STATE_FOUND;
+    }
+
+    /**
+     * @brief Parses an operand followed by every operator which binds tighter than the operator it belongs to
+     * @param precedence Precedence of the operator the operand belongs to
+     */
+    evaluation_state ast_builder::parse_binary(token_cursor& lcurrent, int precedence, expression_node*& result)
+    {
+        nesting_level level(depth);
+        if (depth > MAX_NESTING_DEPTH)
+            return nested_too_deeply(lcurrent, "expression is nested");
+        expression_node* lhs = nullptr;
+        if (parse_operand(lcurrent, lhs) != STATE_FOUND)
+            return STATE_SYNTAX_ERROR;
+        while (!lcurrent.eof())
+        {
+            operator_id id = operators::of(lcurrent.id());
+            if (id == operators::NONE || OPERATOR_TABLE[id].helper) // the operand ends here, the caller checks how
+                break;
+            if (OPERATOR_TABLE[id].suffix != operators::NONE)
+                id = OPERATOR_TABLE[id].suffix;
+            const expression_operator* oper = &OPERATOR_TABLE[id];
+            if (oper->operands == 1 && oper->fix == PREFIX_OPERATOR)
+            {
+                asc::err("operator " + lcurrent.value() + " cannot follow an operand", lcurrent.line());
+                delete lhs;
+                return STATE_SYNTAX_ERROR;
+            }
+            // an operator of the same precedence only continues the operand if it is right associative
+            if (oper->precedence < precedence || (oper->precedence == precedence && oper->association == LEFT_OPERATOR_ASSOCATION))
+                break;
+            expression_node* node = new expression_node(node_kinds::OPERATION, lcurrent.id(), lcurrent.line());
+            node->oper = id;
+            node->children.push_back(lhs);
+            lhs = node;
+            lcurrent = lcurrent.next();
+            if (oper->operands == 1) // suffix operator
+                continue;
+            expression_node* rhs = nullptr;
+            evaluation_state state;
+            if (id == operators::SUBSCRIPT) // subscript, closed by a right bracket
+            {
+                if ((state = parse_binary(lcurrent, LOWEST_PRECEDENCE, rhs)) == STATE_FOUND)
+                    state = expect(lcurrent, "]");
+            }
+            else if (id == operators::TERNARY) // ternary, the middle operand is closed by a colon
+            {
+                if ((state = parse_binary(lcurrent, LOWEST_PRECEDENCE, rhs)) == STATE_FOUND)
+                {
+                    node->children.push_back(rhs);
+                    rhs = nullptr;
+                    if ((state = expect(lcurrent, ":")) == STATE_FOUND)
+                        state = parse_binary(lcurrent, oper->precedence, rhs);
+                }
+            }
+            else
+                state = parse_binary(lcurrent, oper->precedence, rhs);
+            if (state != STATE_FOUND)
+            {
+                delete rhs;
+                delete lhs;
+                return STATE_SYNTAX_ERROR;
+            }
+            node->children.push_back(rhs);
+        }
+        result = lhs;
+        return STATE_FOUND;
+    }
+
+    // Parses a literal, name, type, call, parenthesized expression or prefix operator and its operand
+    evaluation_state ast_builder::parse_operand(token_cursor& lcurrent, expression_node*& result)
+    {
+        if (lcurrent.eof())
+        {
+            asc::err("unexpected end of expression");
+            return STATE_SYNTAX_ERROR;
+        }
+        const std::string& value = lcurrent.value();
+        int line = lcurrent.line();
+        // literals
+        if (is_numerical(value))
+        {
+            result = new expression_node(node_kinds::LITERAL, lcurrent.id(), line);
+            lcurrent = lcurrent.next();
+            return STATE_FOUND;
+        }
+        // prefix operators
+        operator_id id = operators::of(lcurrent.id());
+        if (id != operators::NONE)
+        {
+            if (OPERATOR_TABLE[id].prefix != operators::NONE)
+                id = OPERATOR_TABLE[id].prefix;
+            const expression_operator* oper = &OPERATOR_TABLE[id];
+            if (oper->operands != 1 || oper->fix != PREFIX_OPERATOR)
+            {
+                asc::err("operand expected before operator " + value, line);
+                return STATE_SYNTAX_ERROR;
+            }
+            expression_node* node = new expression_node(node_kinds::OPERATION, lcurrent.id(), line);
+            node->oper = id;
+            expression_node* operand = nullptr;
+            if (parse_binary(lcurrent = lcurrent.next(), oper->precedence, operand) != STATE_FOUND)
+            {
+                delete node;
+                return STATE_SYNTAX_ERROR;
+            }
+            node->children.push_back(operand);
+            result = node;
+            return STATE_FOUND;
+        }
+        // parenthesized expressions
+        if (lcurrent == lexemes::LEFT_PARENTHESIS)
+        {
+            if (parse_binary(lcurrent = lcurrent.next(), LOWEST_PRECEDENCE, result) != STATE_FOUND)
+                return STATE_SYNTAX_ERROR;
+            if (expect(lcurrent, ")") != STATE_FOUND)
+            {
+                delete result;
+                result = nullptr;
+                return STATE_SYNTAX_ERROR;
+            }
+            return STATE_FOUND;
+        }
+        // calls, the arguments are kept in the order they are written
+        if (!lcurrent.next().eof() && lcurrent.next() == lexemes::LEFT_PARENTHESIS)
+        {
+            expression_node* node = new expression_node(node_kinds::CALL, lcurrent.id(), line);
+            lcurrent = lcurrent.next().next();
+            while (lcurrent != lexemes::RIGHT_PARENTHESIS)
+            {
+                expression_node* argument = nullptr;
+                // arguments end at the comma separating them, which has the lowest precedence of any operator
+                if (parse_binary(lcurrent, OPERATOR_TABLE[operators::COMMA].precedence, argument) != STATE_FOUND)
+                {
+                    delete node;
+                    return STATE_SYNTAX_ERROR;
+                }
+                node->children.push_back(argument);
+                if (lcurrent == lexemes::COMMA)
+                    lcurrent = lcurrent.next();
+                else if (lcurrent != lexemes::RIGHT_PARENTHESIS)
+                {
+                    expect(lcurrent, ")");
+                    delete node;
+                    return STATE_SYNTAX_ERROR;
+                }
+            }
+            lcurrent = lcurrent.next();
+            result = node;
+            return STATE_FOUND;
+        }
+        if (lcurrent.type() == syntax_types::PUNCTUATOR)
+        {
+            asc::err("expression expected before '" + value + "'", line);
+            return STATE_SYNTAX_ERROR;
+        }
+        // types, as the right hand side of a cast
+        type_expression type;
+        evaluation_state t_state = parse_type(lcurrent, type);
+        if (t_state == STATE_SYNTAX_ERROR)
+            return STATE_SYNTAX_ERROR;
+        if (t_state == STATE_FOUND)
+        {
+            result = new expression_node(node_kinds::TYPE_NAME, type.name, line);
+            result->type = type;
+            return STATE_FOUND;
+        }
+        result = new expression_node(is_string_literal(value) || is_number_literal(value) ?
+            node_kinds::LITERAL : node_kinds::NAME, lcurrent.id(), line);
+        lcurrent = lcurrent.next();
+        return STATE_FOUND;
+    }
+
+    /**
+     * @brief Parses a type, made of its specifiers, modifiers, name and pointer level
+     * @return STATE_NEUTRAL if the tokens do not name a type declared so far
+     */
+    evaluation_state ast_builder::parse_type(token_cursor& lcurrent, type_expression& type)
+    {
+        token_cursor slcurrent = lcurrent;
+        unsigned char signedness = 0;   // 0 - signed, unspecified
+                                        // 1 - signed, specified
+                                        // 2 - unsigned
+        char length = '\0';
+        while (!check_eof(slcurrent, true))
+        {
+            specifier s = specifiers::value_of(slcurrent.value());
+            if (slcurrent == lexemes::SIGNED)
+                signedness = 1;
+            else if (slcurrent == lexemes::UNSIGNED)
+                signedness = 2;
+            else if (slcurrent == lexemes::SHORT)
+                length = 's';
+            else if (slcurrent == lexemes::LONG)
+                length = 'l';
+            else if (s != specifiers::INVALID)
+                type.specifiers.insert(s);
+            else
+                break;
+            slcurrent = slcurrent.next();
+        }
+        if (slcurrent.eof() || (slcurrent.type() != syntax_types::KEYWORD && slcurrent.type() != syntax_types::IDENTIFIER))
+            return STATE_NEUTRAL;
+        lexeme_id name = signedness == 2 || length ? find_lexeme((signedness == 2 ? "u" : "") +
+            (length ? std::string(1, length) : "") + slcurrent.value()) : slcurrent.id();
+        if (name == INVALID_LEXEME || !type_names.count(name))
+            return STATE_NEUTRAL;
+        type.name = name;
+        type.signed_specified = signedness == 1;
+        type.line = slcurrent.line();
+        slcurrent = slcurrent.next();
+        type.pointer_level = 0;
+        if (!check_eof(slcurrent, true) && slcurrent == lexemes::LEFT_BRACKET)
+        {
+            asc::err("obsolete type, use pointers instead", slcurrent.line());
+            return STATE_SYNTAX_ERROR;
+        }
+        while (!check_eof(slcurrent, true) && slcurrent == lexemes::ASTERISK)
+        {
+            type.pointer_level++;
+            slcurrent = slcurrent.next();
+        }
+        lcurrent = slcurrent;
+        return STATE_FOUND;
+    }
+}
\ No newline at end of file
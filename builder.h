@@ -0,0 +1,65 @@
+#ifndef BUILDER_H
+#define BUILDER_H
+
+#include <unordered_set>
+#include <functional>
+
+#include "ast.h"
+#include "tokens.h"
+
+namespace asc
+{
+    const int LOWEST_PRECEDENCE = -1; // below every operator, so an operand parsed at it takes in every operator which follows
+    const int MAX_NESTING_DEPTH = 256; // blocks and operands nested deeper are rejected instead of running the native stack out
+
+    // leading tokens of a statement, read once and shared by whichever parse method the statement is dispatched to
+    typedef struct statement_head
+    {
+        visibility vis = visibilities::INVALID; // INVALID when none is written
+        token_cursor start; // first token after the visibility
+        bool constructor = false;
+        evaluation_state type_state = STATE_NEUTRAL; // result of parsing a type at start
+        type_expression type;
+        token_cursor name; // first token after the type
+    } statement_head;
+
+    /**
+     * @brief Parses a token stream into a syntax tree without generating any code.
+     * Whether a word names a type is decided from the standard types and the types and objects declared
+     * before it, which is all the parser needs to tell declarations apart from expressions.
+     */
+    class ast_builder
+    {
+    private:
+        std::unordered_set<lexeme_id> type_names;
+        statement_node* scope; // function, object, if statement or while loop being parsed, null if global
+        bool streaming; // release tokens once the statement they belong to is parsed
+        bool experimental; // parse if statements, while loops and namespaces
+        int depth; // blocks and operands being parsed inside one another
+
+        evaluation_state parse_block(token_cursor& lcurrent, statement_list& body, statement_node* block);
+        evaluation_state parse_statement(token_cursor& lcurrent, statement_node*& result);
+        void read_head(token_cursor lcurrent, statement_head& head);
+        evaluation_state parse_use(token_cursor& lcurrent, statement_node*& result);
+        evaluation_state parse_function(token_cursor& lcurrent, statement_head& head, function_node*& result, bool use_declaration);
+        evaluation_state parse_var_declaration(token_cursor& lcurrent, statement_head& head, statement_node*& result);
+        evaluation_state parse_type_construct(token_cursor& lcurrent, statement_head& head, statement_node*& result);
+        evaluation_state parse_object_construct(token_cursor& lcurrent, statement_head& head, statement_node*& result);
+        evaluation_state parse_namespace(token_cursor& lcurrent, statement_node*& result);
+        evaluation_state parse_conditional(token_cursor& lcurrent, statement_node*& result);
+        evaluation_state parse_expression_statement(token_cursor& lcurrent, statement_node*& result, node_kind kind);
+        evaluation_state parse_binary(token_cursor& lcurrent, int precedence, expression_node*& result);
+        evaluation_state parse_operand(token_cursor& lcurrent, expression_node*& result);
+    public:
+        token_cursor current; // token after the last statement parsed
+        std::function<bool(const std::string& path, std::unordered_set<lexeme_id>& type_names)> use_module; // makes a used module's types known, false if it cannot be compiled
+
+        ast_builder(token_cursor root, bool streaming = false, bool experimental = false);
+        bool parseable();
+        evaluation_state parse(translation_unit& unit);
+        evaluation_state parse_expression(token_cursor& lcurrent, expression_node*& result, lexeme_id terminator = lexemes::SEMICOLON);
+        evaluation_state parse_type(token_cursor& lcurrent, type_expression& type);
+    };
+}
+
+#endif
\ No newline at end of file
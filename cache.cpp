@@ -0,0 +1,235 @@
+#include <fstream>
+#include <unordered_map>
+#include <cstdio>
+#include <cstring>
+#include <cerrno>
+
+#ifdef _WIN32
+#include <direct.h>
+#else
+#include <sys/stat.h>
+#endif
+
+#include "cache.h"
+#include "tokenizer.h"
+#include "logger.h"
+
+namespace asc
+{
+    const char CACHE_MAGIC[4] = { 'A', 'S', 'C', 'T' };
+
+    /*
+     * Layout of a cache entry, every section starting on a 4 byte boundary:
+     * header, lexeme lengths, lexeme text, token types, token lexemes (indices into the entry's lexemes),
+     * token offsets, token lines
+     */
+    typedef struct cache_header
+    {
+        char magic[4];
+        unsigned int version; // LEXER_VERSION of the lexer which produced the tokens
+        unsigned long long hash; // content_hash of the source
+        unsigned long long source_length;
+        unsigned int tokens;
+        unsigned int lexemes;
+        unsigned int lexeme_bytes;
+        unsigned int reserved;
+    } cache_header;
+
+    static size_t align4(size_t n)
+    {
+        return (n + 3) & ~(size_t) 3;
+    }
+
+    // Size of an entry with the given header, so a truncated entry is caught before anything is read from it
+    static size_t entry_size(const cache_header& header)
+    {
+        return sizeof(cache_header) + header.lexemes * sizeof(unsigned int) + align4(header.lexeme_bytes) +
+            align4(header.tokens) + (size_t) header.tokens * (sizeof(unsigned int) * 2 + sizeof(int));
+    }
+
+    // Creates the directory and the directories it is in, true if it exists afterwards
+    static bool make_directories(const std::string& directory)
+    {
+        for (size_t i = 1; i <= directory.length(); i++)
+        {
+            if (i != directory.length() && directory[i] != '/' && directory[i] != '\\')
+                continue;
+            std::string prefix = directory.substr(0, i);
+#ifdef _WIN32
+            if (_mkdir(prefix.c_str()) != 0 && errno != EEXIST)
+                return false;
+#else
+            if (mkdir(prefix.c_str(), 0755) != 0 && errno != EEXIST)
+                return false;
+#endif
+        }
+        return true;
+    }
+
+    // 64-bit FNV-1a
+    unsigned long long content_hash(const char* data, size_t length)
+    {
+        unsigned long long h = 14695981039346656037ull;
+        for (size_t i = 0; i < length; i++)
+            h = (h ^ (unsigned char) data[i]) * 1099511628211ull;
+        return h;
+    }
+
+    token_cache::token_cache()
+    {
+        this->directory_ready = false;
+        this->hits = 0;
+        this->misses = 0;
+    }
+
+    void token_cache::open(const std::string& directory)
+    {
+        this->directory = directory;
+        this->directory_ready = false;
+    }
+
+    bool token_cache::enabled()
+    {
+        return !directory.empty();
+    }
+
+    std::string token_cache::entry_path(unsigned long long hash)
+    {
+        char name[32];
+        std::snprintf(name, sizeof(name), "%016llx.tok", hash);
+        return directory + '/' + name;
+    }
+
+    // Reads the entry at the path into the buffer, false if it is missing, damaged or was made for other source code
+    bool token_cache::load(const std::string& path, source_file& source, unsigned long long hash, token_buffer& tokens)
+    {
+        source_file entry(path);
+        if (!entry.good() || entry.length() < sizeof(cache_header))
+            return false;
+        cache_header header;
+        std::memcpy(&header, entry.data(), sizeof(cache_header));
+        if (std::memcmp(header.magic, CACHE_MAGIC, sizeof(CACHE_MAGIC)) != 0 || header.version != LEXER_VERSION ||
+            header.hash != hash || header.source_length != source.length() || entry.length() != entry_size(header))
+            return false;
+        const char* p = entry.data() + sizeof(cache_header);
+        const char* text = p + header.lexemes * sizeof(unsigned int);
+        const char* text_end = text + header.lexeme_bytes;
+        std::vector<lexeme_id> lexemes(header.lexemes);
+        for (unsigned int i = 0; i < header.lexemes; i++, p += sizeof(unsigned int))
+        {
+            unsigned int length;
+            std::memcpy(&length, p, sizeof(unsigned int));
+            if (length > (size_t) (text_end - text))
+                return false;
+            lexemes[i] = intern(text, length);
+            text += length;
+        }
+        p = entry.data() + sizeof(cache_header) + header.lexemes * sizeof(unsigned int) + align4(header.lexeme_bytes);
+        size_t count = header.tokens;
+        tokens.types.assign(p, p + count);
+        p += align4(count);
+        tokens.ids.resize(count);
+        std::memcpy(tokens.ids.data(), p, count * sizeof(unsigned int));
+        p += count * sizeof(unsigned int);
+        for (lexeme_id& id : tokens.ids)
+        {
+            if (id >= header.lexemes)
+                return false;
+            id = lexemes[id];
+        }
+        tokens.offsets.resize(count);
+        std::memcpy(tokens.offsets.data(), p, count * sizeof(unsigned int));
+        p += count * sizeof(unsigned int);
+        tokens.lines.resize(count);
+        std::memcpy(tokens.lines.data(), p, count * sizeof(int));
+        return true;
+    }
+
+    // Writes the buffer to the entry at the path, through a temporary file so a reader never sees half an entry
+    bool token_cache::store(const std::string& path, source_file& source, unsigned long long hash, token_buffer& tokens)
+    {
+        if (!directory_ready && !(directory_ready = make_directories(directory)))
+            return false;
+        std::vector<unsigned int> local_ids(tokens.size()); // lexeme ids renumbered densely for this entry
+        std::vector<lexeme_id> lexemes;
+        std::unordered_map<lexeme_id, unsigned int> local_of;
+        for (size_t i = 0; i < tokens.size(); i++)
+        {
+            auto it = local_of.find(tokens.ids[i]);
+            if (it == local_of.end())
+            {
+                it = local_of.emplace(tokens.ids[i], (unsigned int) lexemes.size()).first;
+                lexemes.push_back(tokens.ids[i]);
+            }
+            local_ids[i] = it->second;
+        }
+        std::vector<unsigned int> lengths;
+        std::string text;
+        for (lexeme_id id : lexemes)
+        {
+            const std::string& value = lexeme(id);
+            lengths.push_back(value.length());
+            text += value;
+        }
+        cache_header header;
+        std::memcpy(header.magic, CACHE_MAGIC, sizeof(CACHE_MAGIC));
+        header.version = LEXER_VERSION;
+        header.hash = hash;
+        header.source_length = source.length();
+        header.tokens = tokens.size();
+        header.lexemes = lexemes.size();
+        header.lexeme_bytes = text.length();
+        header.reserved = 0;
+        const char padding[4] = {};
+        std::string temporary = path + ".tmp";
+        std::ofstream os(temporary, std::ios::binary | std::ios::trunc);
+        os.write((const char*) &header, sizeof(cache_header));
+        os.write((const char*) lengths.data(), lengths.size() * sizeof(unsigned int));
+        os.write(text.data(), text.length());
+        os.write(padding, align4(text.length()) - text.length());
+        os.write((const char*) tokens.types.data(), tokens.size());
+        os.write(padding, align4(tokens.size()) - tokens.size());
+        os.write((const char*) local_ids.data(), local_ids.size() * sizeof(unsigned int));
+        os.write((const char*) tokens.offsets.data(), tokens.size() * sizeof(unsigned int));
+        os.write((const char*) tokens.lines.data(), tokens.size() * sizeof(int));
+        os.close();
+        if (os.fail())
+        {
+            std::remove(temporary.c_str());
+            return false;
+        }
+        std::remove(path.c_str()); // renaming over an existing file fails on Windows
+        return std::rename(temporary.c_str(), path.c_str()) == 0;
+    }
+
+    /**
+     * @brief Tokenizes source code, loading its tokens from the cache when an earlier compilation saved them.
+     *
+     * @param source Source code to tokenize
+     * @param tokenizer Tokenizer used on a miss, its tokens are saved for the next compilation
+     * @return Tokens of the source code
+     */
+    token_buffer token_cache::tokenize(source_file& source, const std::function<token_buffer(source_file&)>& tokenizer)
+    {
+        unsigned long long hash = content_hash(source.data(), source.length());
+        std::string path = entry_path(hash);
+        token_buffer tokens;
+        if (load(path, source, hash, tokens))
+        {
+            hits++;
+            asc::debug("token cache hit: " + path);
+            return tokens;
+        }
+        misses++;
+        asc::debug("token cache miss: " + path);
+        tokens = tokenizer(source);
+        if (!store(path, source, hash, tokens))
+            asc::warn("could not write token cache entry " + path);
+        return tokens;
+    }
+
+    std::string token_cache::report()
+    {
+        return "token cache: " + std::to_string(hits) + " hits, " + std::to_string(misses) + " misses";
+    }
+}
\ No newline at end of file
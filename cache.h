@@ -0,0 +1,42 @@
+#ifndef CACHE_H
+#define CACHE_H
+
+#include <string>
+#include <cstddef>
+#include <functional>
+
+#include "tokens.h"
+#include "source.h"
+
+namespace asc
+{
+    /**
+     * @brief Directory of token streams saved by earlier compilations.
+     * Each entry is named after a hash of the source it was lexed from and records the lexer version
+     * that produced it, so an edited file or a newer lexer misses instead of loading stale tokens.
+     * Lexemes are stored as text because lexeme ids are only meaningful within one run of the compiler.
+     */
+    class token_cache
+    {
+    private:
+        std::string directory;
+        bool directory_ready;
+
+        std::string entry_path(unsigned long long hash);
+        bool load(const std::string& path, source_file& source, unsigned long long hash, token_buffer& tokens);
+        bool store(const std::string& path, source_file& source, unsigned long long hash, token_buffer& tokens);
+    public:
+        unsigned int hits;
+        unsigned int misses;
+
+        token_cache();
+        void open(const std::string& directory);
+        bool enabled();
+        token_buffer tokenize(source_file& source, const std::function<token_buffer(source_file&)>& tokenizer);
+        std::string report();
+    };
+
+    unsigned long long content_hash(const char* data, size_t length);
+}
+
+#endif
\ No newline at end of file
@@ -1,15 +1,24 @@
+#include <cstdlib>
+
 #include "cli.h"
 #include "logger.h"
 
 namespace asc
 {
-    std::vector<help_reference> REFERENCE_OPTIONS {
+    const std::vector<help_reference> REFERENCE_OPTIONS {
         {"--help", "Shows this menu"},
         {"-debug", "Shows debug information while compiling"},
         {"-tokenize", "Tokenizes the input file and displays it"},
+        {"-ast", "Parses the input file and displays its abstract syntax tree"},
         {"-symbolize", "Analyzes symbols created by asc and displays them"},
         {"-experimental", "Compile files using bleeding-edge code"},
         {"-expressions", "Gives information about A# expressions in a file"},
+        {"-regextokenizer", "Tokenize files with the legacy regex-based tokenizer"},
+        {"-benchmark", "Measures the throughput of the tokenizers on the input files"},
+        {"-stream", "Tokenizes files while they are compiled, holding only a window of tokens in memory"},
+        {"-lexthreads <count>", "Tokenizes large files across the given number of threads"},
+        {"-j <count>", "Assembles up to the given number of files at once while the next files are compiled"},
+        {"-cache <directory>", "Reuses the tokens of unchanged files from the given directory and reports cache hits and misses"},
         {"-o <location>", "Specifies an output location"}
     };
 
@@ -18,11 +27,15 @@ namespace asc
         arg_result as;
         as.output_location = "a";
         as.options = 0;
+        as.lex_threads = 1;
+        as.jobs = 1;
         for (int i = 1; i < argc; i++)
         {
             std::string arg = std::string(argv[i]);
             if (arg == "-tokenize")
                 as.options |= cli_options::TOKENIZE;
+            else if (arg == "-ast")
+                as.options |= cli_options::AST;
             else if (arg == "--help")
                 as.options |= cli_options::HELP;
             else if (arg == "-symbolize")
@@ -33,6 +46,45 @@ namespace asc
                 as.options |= cli_options::EXPERIMENTAL;
             else if (arg == "-expressions")
                 as.options |= cli_options::EXPRESSIONS;
+            else if (arg == "-regextokenizer")
+                as.options |= cli_options::REGEX_TOKENIZER;
+            else if (arg == "-benchmark")
+                as.options |= cli_options::BENCHMARK;
+            else if (arg == "-stream")
+                as.options |= cli_options::STREAM;
+            else if (arg == "-lexthreads")
+            {
+                if (++i >= argc)
+                    asc::warn("thread count not specified, tokenizing serially");
+                else
+                {
+                    int threads = std::atoi(argv[i]);
+                    if (threads < 1)
+                        asc::warn("invalid thread count " + std::string(argv[i]) + ", tokenizing serially");
+                    else
+                        as.lex_threads = threads;
+                }
+            }
+            else if (arg == "-j")
+            {
+                if (++i >= argc)
+                    asc::warn("job count not specified, assembling serially");
+                else
+                {
+                    int jobs = std::atoi(argv[i]);
+                    if (jobs < 1)
+                        asc::warn("invalid job count " + std::string(argv[i]) + ", assembling serially");
+                    else
+                        as.jobs = jobs;
+                }
+            }
+            else if (arg == "-cache")
+            {
+                if (++i >= argc)
+                    asc::warn("cache directory not specified, not caching tokens");
+                else
+                    as.cache_directory = argv[i];
+            }
             else if (arg == "-o")
             {
                 arg = std::string(argv[++i]);
@@ -14,6 +14,10 @@ namespace asc
         const unsigned long long DEBUG = 1 << 3;
         const unsigned long long EXPERIMENTAL = 1 << 4;
         const unsigned long long EXPRESSIONS = 1 << 5;
+        const unsigned long long REGEX_TOKENIZER = 1 << 6;
+        const unsigned long long BENCHMARK = 1 << 7;
+        const unsigned long long STREAM = 1 << 8;
+        const unsigned long long AST = 1 << 9;
     }
 
     typedef struct arg_result
@@ -21,6 +25,9 @@ namespace asc
         std::vector<std::string> files;
         unsigned long long options;
         std::string output_location;
+        unsigned int lex_threads; // threads to tokenize each file with, 1 to tokenize serially
+        unsigned int jobs; // files assembled at once, 1 to assemble each file before the next is compiled
+        std::string cache_directory; // where tokens are cached between compilations, empty to not cache them
     } arg_result;
 
     typedef struct help_reference
@@ -29,7 +36,7 @@ namespace asc
         std::string description;
     } help_reference;
 
-    extern std::vector<help_reference> REFERENCE_OPTIONS;
+    extern const std::vector<help_reference> REFERENCE_OPTIONS;
 
     arg_result eval_args(int argc, char**& argv);
     bool has_option_set(arg_result& as, unsigned long long option);
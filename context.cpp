@@ -0,0 +1,15 @@
+#include "context.h"
+
+namespace asc
+{
+    compilation_context::compilation_context(const arg_result& args): args(args), assembler_jobs(args.jobs)
+    {
+        this->assembler = "nasm";
+        this->linker = "gcc";
+    }
+
+    bool compilation_context::option(unsigned long long option)
+    {
+        return has_option_set(args, option);
+    }
+}
\ No newline at end of file
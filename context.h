@@ -0,0 +1,39 @@
+#ifndef CONTEXT_H
+#define CONTEXT_H
+
+#include <string>
+#include <vector>
+
+#include "cli.h"
+#include "module.h"
+#include "build.h"
+#include "cache.h"
+#include "jobs.h"
+
+namespace asc
+{
+    /**
+     * @brief Everything one compilation reads its settings from and keeps its state in, passed to whatever needs it.
+     * The tables the compiler looks types, registers and operators up in are constant and shared by every context,
+     * and the lexeme interner locks while it interns, so compilations with contexts of their own can run on separate threads.
+     */
+    class compilation_context
+    {
+    public:
+        arg_result args;
+        std::string assembler; // from the options file
+        std::string linker;
+        std::vector<std::string> object_files; // in the order they are linked
+        module_registry modules;
+        build_database builds; // how the program was built last, so unchanged modules are reused
+        token_cache tokens;
+        job_pool assembler_jobs; // last, so the jobs still running finish before the rest of the context is destroyed
+
+        compilation_context(const arg_result& args);
+        compilation_context(const compilation_context&) = delete;
+        compilation_context& operator=(const compilation_context&) = delete;
+        bool option(unsigned long long option);
+    };
+}
+
+#endif
\ No newline at end of file
@@ -0,0 +1,169 @@
+#include <fstream>
+#include <cstring>
+
+#include "interface.h"
+
+namespace asc
+{
+    const char INTERFACE_MAGIC[4] = { 'A', 'S', 'C', 'I' };
+
+    /*
+     * Layout of an interface file, every section starting on a 4 byte boundary:
+     * header, string lengths, string text, namespaces, types, fields, globals, functions, parameters
+     */
+    typedef struct interface_header
+    {
+        char magic[4];
+        unsigned int version; // INTERFACE_VERSION of the compiler which wrote the file
+        unsigned int strings;
+        unsigned int string_bytes;
+        unsigned int namespaces;
+        unsigned int types;
+        unsigned int fields;
+        unsigned int globals;
+        unsigned int functions;
+        unsigned int parameters;
+    } interface_header;
+
+    static size_t align4(size_t n)
+    {
+        return (n + 3) & ~(size_t) 3;
+    }
+
+    template <typename T> static void write_section(std::ofstream& os, const std::vector<T>& records)
+    {
+        os.write((const char*) records.data(), records.size() * sizeof(T));
+    }
+
+    // Copies a section out of the file, false if the file ends before it does
+    template <typename T> static bool read_section(const char*& p, const char* end, unsigned int count, std::vector<T>& records)
+    {
+        if ((size_t) count * sizeof(T) > (size_t) (end - p))
+            return false;
+        records.resize(count);
+        std::memcpy(records.data(), p, count * sizeof(T));
+        p += count * sizeof(T);
+        return true;
+    }
+
+    // Index of a string in the interface, adding it the first time it is used
+    unsigned int module_interface::string(const std::string& str)
+    {
+        auto it = string_indices.find(str);
+        if (it != string_indices.end())
+            return it->second;
+        strings.push_back(str);
+        return string_indices[str] = strings.size() - 1;
+    }
+
+    bool module_interface::write(const std::string& path)
+    {
+        std::ofstream os(path, std::ios::binary | std::ios::trunc);
+        if (!os.good())
+            return false;
+        interface_header header;
+        std::memcpy(header.magic, INTERFACE_MAGIC, sizeof(INTERFACE_MAGIC));
+        header.version = INTERFACE_VERSION;
+        header.strings = strings.size();
+        header.string_bytes = 0;
+        std::vector<unsigned int> lengths;
+        for (const std::string& str : strings)
+        {
+            lengths.push_back(str.length());
+            header.string_bytes += str.length();
+        }
+        header.namespaces = namespaces.size();
+        header.types = types.size();
+        header.fields = fields.size();
+        header.globals = globals.size();
+        header.functions = functions.size();
+        header.parameters = parameters.size();
+        os.write((const char*) &header, sizeof(header));
+        write_section(os, lengths);
+        for (const std::string& str : strings)
+            os.write(str.data(), str.length());
+        os.write("\0\0\0", align4(header.string_bytes) - header.string_bytes);
+        write_section(os, namespaces);
+        write_section(os, types);
+        write_section(os, fields);
+        write_section(os, globals);
+        write_section(os, functions);
+        write_section(os, parameters);
+        return os.good();
+    }
+
+    /**
+     * @brief Loads the interface file at the path, mapping it into memory and copying its sections out whole
+     * @return False if the file is missing, damaged or was written by another version of the compiler
+     */
+    bool module_interface::read(const std::string& path)
+    {
+        source_file file(path);
+        if (!file.good() || file.length() < sizeof(interface_header))
+            return false;
+        interface_header header;
+        std::memcpy(&header, file.data(), sizeof(interface_header));
+        if (std::memcmp(header.magic, INTERFACE_MAGIC, sizeof(INTERFACE_MAGIC)) != 0 || header.version != INTERFACE_VERSION)
+            return false;
+        const char* p = file.data() + sizeof(interface_header);
+        const char* end = file.data() + file.length();
+        std::vector<unsigned int> lengths;
+        if (!read_section(p, end, header.strings, lengths) || align4(header.string_bytes) > (size_t) (end - p))
+            return false;
+        const char* text = p;
+        const char* text_end = p + header.string_bytes;
+        strings.clear();
+        string_indices.clear();
+        for (unsigned int length : lengths)
+        {
+            if (length > (size_t) (text_end - text))
+                return false;
+            strings.emplace_back(text, length);
+            text += length;
+        }
+        p += align4(header.string_bytes);
+        if (!read_section(p, end, header.namespaces, namespaces) || !read_section(p, end, header.types, types) ||
+            !read_section(p, end, header.fields, fields) || !read_section(p, end, header.globals, globals) ||
+            !read_section(p, end, header.functions, functions) || !read_section(p, end, header.parameters, parameters))
+            return false;
+        return p == end && consistent();
+    }
+
+    // Whether every index in the records is in range, so a damaged file is turned away before it is declared
+    bool module_interface::consistent()
+    {
+        size_t s = strings.size(), n = namespaces.size();
+        for (size_t i = 0; i < n; i++) // a namespace is only ever in one written before it
+        {
+            if (namespaces[i].name >= s || namespaces[i].ns > i)
+                return false;
+        }
+        for (interface_type& record : types)
+        {
+            if (record.name >= s || record.ns > n || (size_t) record.first_field + record.fields > fields.size())
+                return false;
+        }
+        for (interface_field& record : fields)
+        {
+            if (record.name >= s || record.type.name >= s)
+                return false;
+        }
+        for (interface_global& record : globals)
+        {
+            if (record.name >= s || record.ns > n || record.type.name >= s)
+                return false;
+        }
+        for (interface_function& record : functions)
+        {
+            if (record.name >= s || record.ns > n || record.type.name >= s ||
+                (size_t) record.first_parameter + record.parameters > parameters.size())
+                return false;
+        }
+        for (interface_parameter& record : parameters)
+        {
+            if (record.name >= s || record.type.name >= s)
+                return false;
+        }
+        return true;
+    }
+}
\ No newline at end of file
@@ -0,0 +1,98 @@
+#ifndef INTERFACE_H
+#define INTERFACE_H
+
+#include <string>
+#include <vector>
+#include <unordered_map>
+
+#include "interner.h"
+#include "source.h"
+
+namespace asc
+{
+    const unsigned int INTERFACE_VERSION = 1; // raise whenever the layout of interface files changes
+    const unsigned int NO_NAMESPACE = 0; // namespace of a declaration made outside of every namespace
+
+    /*
+     * Records of an interface file, each made of 32-bit fields so a section is copied out of the file as it is.
+     * Names are indices into the file's strings, namespaces are indices of namespace records plus one.
+     */
+    typedef struct interface_type_ref
+    {
+        unsigned int name;
+        unsigned int pointer_level;
+        unsigned int specifiers; // bit s set for specifier s
+    } interface_type_ref;
+
+    typedef struct interface_namespace
+    {
+        unsigned int name;
+        unsigned int ns; // enclosing namespace
+    } interface_namespace;
+
+    typedef struct interface_type
+    {
+        unsigned int name;
+        unsigned int ns;
+        unsigned int variant; // STRUCTLIKE_TYPE or OBJECT
+        unsigned int size;
+        unsigned int first_field;
+        unsigned int fields;
+    } interface_type;
+
+    typedef struct interface_field
+    {
+        unsigned int name;
+        interface_type_ref type;
+        unsigned int offset; // from the start of the type
+    } interface_field;
+
+    typedef struct interface_global
+    {
+        unsigned int name;
+        unsigned int ns;
+        interface_type_ref type;
+    } interface_global;
+
+    typedef struct interface_function
+    {
+        unsigned int name;
+        unsigned int ns;
+        interface_type_ref type; // return type
+        unsigned int first_parameter;
+        unsigned int parameters;
+    } interface_function;
+
+    typedef struct interface_parameter
+    {
+        unsigned int name;
+        interface_type_ref type;
+    } interface_parameter;
+
+    /**
+     * @brief Public declarations of a compiled module: its namespaces, the layouts of its types and objects,
+     * its globals and the signatures of its functions. Files using the module declare these instead of compiling it.
+     * Declarations refer to one another by index, types before the globals and functions which use them.
+     */
+    class module_interface
+    {
+    private:
+        std::unordered_map<std::string, unsigned int> string_indices;
+
+        bool consistent();
+    public:
+        std::vector<std::string> strings;
+        std::vector<interface_namespace> namespaces;
+        std::vector<interface_type> types;
+        std::vector<interface_field> fields;
+        std::vector<interface_global> globals;
+        std::vector<interface_function> functions;
+        std::vector<interface_parameter> parameters;
+
+        unsigned int string(const std::string& str);
+        bool write(const std::string& path);
+        bool read(const std::string& path);
+    };
+}
+
+#endif
\ No newline at end of file
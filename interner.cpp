@@ -0,0 +1,142 @@
+#include "interner.h"
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
+namespace asc
+{
+    // must stay in the same order as the ids in the lexemes namespace
+    const char* WELL_KNOWN_LEXEMES[] = {
+        ";", "(", ")", "{", "}", ",", "=", "~=", "*", "[", ".",
+        "use", "native", "return", "delete", "type", "object", "extends", "namespace",
+        "constructor", "if", "while", "signed", "unsigned", "short", "long", "this",
+        // standard types, in the order of the table so they are numbered the same in every run
+        "void", "byte", "ubyte", "bool", "char", "sint", "usint", "int", "uint", "lint", "ulint", "real", "lreal"
+    };
+
+    // Index of the highest set bit, x must not be 0
+    static unsigned int leading_bit(unsigned long long x)
+    {
+#if defined(_MSC_VER)
+        unsigned long index;
+        _BitScanReverse64(&index, x);
+        return index;
+#else
+        return 63 - __builtin_clzll(x);
+#endif
+    }
+
+    string_interner::string_interner()
+    {
+        count = 0;
+        slots.assign(256, INVALID_LEXEME);
+        for (const char* lexeme : WELL_KNOWN_LEXEMES)
+            intern(lexeme, std::char_traits<char>::length(lexeme));
+    }
+
+    // FNV-1a
+    unsigned int string_interner::hash(const char* text, size_t length)
+    {
+        unsigned int h = 2166136261u;
+        for (size_t i = 0; i < length; i++)
+            h = (h ^ (unsigned char) text[i]) * 16777619u;
+        return h;
+    }
+
+    std::string& string_interner::at(lexeme_id id)
+    {
+        unsigned long long biased = (unsigned long long) id + (1ull << FIRST_LEXEME_BLOCK_BITS);
+        unsigned int block = leading_bit(biased) - FIRST_LEXEME_BLOCK_BITS;
+        return blocks[block][biased - (1ull << (block + FIRST_LEXEME_BLOCK_BITS))];
+    }
+
+    size_t string_interner::slot(const char* text, size_t length, unsigned int h)
+    {
+        size_t mask = slots.size() - 1;
+        for (size_t i = h & mask;; i = (i + 1) & mask)
+        {
+            lexeme_id id = slots[i];
+            if (id == INVALID_LEXEME || (hashes[id] == h && at(id).compare(0, std::string::npos, text, length) == 0))
+                return i;
+        }
+    }
+
+    void string_interner::grow()
+    {
+        slots.assign(slots.size() * 2, INVALID_LEXEME);
+        size_t mask = slots.size() - 1;
+        for (lexeme_id id = 0; id < count; id++)
+        {
+            size_t i = hashes[id] & mask;
+            for (; slots[i] != INVALID_LEXEME; i = (i + 1) & mask);
+            slots[i] = id;
+        }
+    }
+
+    lexeme_id string_interner::intern(const char* text, size_t length)
+    {
+        unsigned int h = hash(text, length);
+        size_t i = slot(text, length, h);
+        if (slots[i] != INVALID_LEXEME)
+            return slots[i];
+        lexeme_id id = count;
+        unsigned long long biased = (unsigned long long) id + (1ull << FIRST_LEXEME_BLOCK_BITS);
+        unsigned int block = leading_bit(biased) - FIRST_LEXEME_BLOCK_BITS;
+        if (blocks[block] == nullptr) // the block is in place before its first id is handed out
+            blocks[block].reset(new std::string[1ull << (block + FIRST_LEXEME_BLOCK_BITS)]);
+        at(id).assign(text, length);
+        count++;
+        hashes.push_back(h);
+        slots[i] = id;
+        if (count * 2 > slots.size()) // keep the load factor at or below one half
+            grow();
+        return id;
+    }
+
+    lexeme_id string_interner::find(const char* text, size_t length)
+    {
+        return slots[slot(text, length, hash(text, length))];
+    }
+
+    const std::string& string_interner::get(lexeme_id id)
+    {
+        return at(id);
+    }
+
+    size_t string_interner::size()
+    {
+        return count;
+    }
+
+    // the interner is created on first use, so it is ready for whichever compilation interns first
+    string_interner& interner()
+    {
+        static string_interner si;
+        return si;
+    }
+
+    lexeme_id intern(const char* text, size_t length)
+    {
+        string_interner& si = interner();
+        std::lock_guard<std::mutex> guard(si.lock);
+        return si.intern(text, length);
+    }
+
+    lexeme_id intern(const std::string& str)
+    {
+        return intern(str.data(), str.length());
+    }
+
+    lexeme_id find_lexeme(const std::string& str)
+    {
+        string_interner& si = interner();
+        std::lock_guard<std::mutex> guard(si.lock);
+        return si.find(str.data(), str.length());
+    }
+
+    const std::string& lexeme(lexeme_id id)
+    {
+        return interner().get(id);
+    }
+}
\ No newline at end of file
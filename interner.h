@@ -0,0 +1,86 @@
+#ifndef INTERNER_H
+#define INTERNER_H
+
+#include <string>
+#include <vector>
+#include <memory>
+#include <mutex>
+#include <cstddef>
+
+namespace asc
+{
+    typedef unsigned int lexeme_id;
+
+    const lexeme_id INVALID_LEXEME = (lexeme_id) -1;
+
+    const unsigned int FIRST_LEXEME_BLOCK_BITS = 8; // the first block of lexemes holds 2^8, each block after it twice the one before
+
+    /**
+     * @brief Stores every distinct lexeme once and hands out a dense integer id for it.
+     * Lookups hash the raw bytes, so interning a token straight out of the source does not allocate
+     * unless the lexeme has never been seen before.
+     * Lexemes are kept in blocks which are never moved or freed, so getting a lexeme by id needs no lock
+     * while another thread interns. Interning into an interner shared between threads has to hold its lock.
+     */
+    class string_interner
+    {
+    private:
+        std::unique_ptr<std::string[]> blocks[32]; // block b holds the ids from 2^(b + 8) - 2^8 up to twice that
+        size_t count;
+        std::vector<lexeme_id> slots; // open addressing table of ids, INVALID_LEXEME when empty
+        std::vector<unsigned int> hashes;
+
+        static unsigned int hash(const char* text, size_t length);
+        std::string& at(lexeme_id id);
+        size_t slot(const char* text, size_t length, unsigned int h);
+        void grow();
+    public:
+        std::mutex lock;
+
+        string_interner();
+        lexeme_id intern(const char* text, size_t length);
+        lexeme_id find(const char* text, size_t length);
+        const std::string& get(lexeme_id id);
+        size_t size();
+    };
+
+    // well-known lexemes, interned up front so the parser can compare against them directly
+    namespace lexemes
+    {
+        const lexeme_id SEMICOLON = 0;
+        const lexeme_id LEFT_PARENTHESIS = 1;
+        const lexeme_id RIGHT_PARENTHESIS = 2;
+        const lexeme_id LEFT_BRACE = 3;
+        const lexeme_id RIGHT_BRACE = 4;
+        const lexeme_id COMMA = 5;
+        const lexeme_id ASSIGNMENT = 6;
+        const lexeme_id ALLOCATION = 7;
+        const lexeme_id ASTERISK = 8;
+        const lexeme_id LEFT_BRACKET = 9;
+        const lexeme_id DOT = 10;
+        const lexeme_id USE = 11;
+        const lexeme_id NATIVE = 12;
+        const lexeme_id RETURN = 13;
+        const lexeme_id DELETE_STATEMENT = 14;
+        const lexeme_id TYPE = 15;
+        const lexeme_id OBJECT = 16;
+        const lexeme_id EXTENDS = 17;
+        const lexeme_id NAMESPACE = 18;
+        const lexeme_id CONSTRUCTOR = 19;
+        const lexeme_id IF = 20;
+        const lexeme_id WHILE = 21;
+        const lexeme_id SIGNED = 22;
+        const lexeme_id UNSIGNED = 23;
+        const lexeme_id SHORT = 24;
+        const lexeme_id LONG = 25;
+        const lexeme_id THIS = 26;
+    }
+
+    string_interner& interner(); // shared by every compilation, the functions below lock it
+    lexeme_id intern(const char* text, size_t length);
+    lexeme_id intern(const std::string& str);
+    lexeme_id find_lexeme(const std::string& str);
+    const std::string& lexeme(lexeme_id id);
+}
+
+#endif
\ No newline at end of file
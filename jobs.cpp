@@ -0,0 +1,65 @@
+#include "jobs.h"
+
+namespace asc
+{
+    job_pool::job_pool(unsigned int threads)
+    {
+        this->running = 0;
+        this->closing = false;
+        for (unsigned int i = 0; threads > 1 && i < threads; i++)
+            workers.emplace_back(&job_pool::work, this);
+    }
+
+    // Takes jobs off the queue until the pool closes with nothing left to run
+    void job_pool::work()
+    {
+        std::unique_lock<std::mutex> guard(lock);
+        while (true)
+        {
+            available.wait(guard, [this] { return closing || !pending.empty(); });
+            if (pending.empty())
+                return;
+            job j = std::move(pending.front());
+            pending.pop();
+            running++;
+            guard.unlock();
+            j();
+            guard.lock();
+            running--;
+            if (running == 0 && pending.empty())
+                idle.notify_all();
+        }
+    }
+
+    void job_pool::submit(job j)
+    {
+        if (workers.empty())
+        {
+            j();
+            return;
+        }
+        {
+            std::lock_guard<std::mutex> guard(lock);
+            pending.push(std::move(j));
+        }
+        available.notify_one();
+    }
+
+    // Blocks until every job submitted so far has finished
+    void job_pool::wait()
+    {
+        std::unique_lock<std::mutex> guard(lock);
+        idle.wait(guard, [this] { return running == 0 && pending.empty(); });
+    }
+
+    job_pool::~job_pool()
+    {
+        {
+            std::lock_guard<std::mutex> guard(lock);
+            closing = true;
+        }
+        available.notify_all();
+        for (auto& worker : workers)
+            worker.join();
+    }
+}
\ No newline at end of file
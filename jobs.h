@@ -0,0 +1,42 @@
+#ifndef JOBS_H
+#define JOBS_H
+
+#include <vector>
+#include <queue>
+#include <functional>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+
+namespace asc
+{
+    typedef std::function<void()> job;
+
+    /**
+     * @brief Workers which run jobs in the background while the thread submitting them goes on.
+     * Jobs start in the order they are submitted but may finish in any order, so anything which has to come out
+     * in order is collected by the submitter. A pool of one worker runs each job as it is submitted instead.
+     */
+    class job_pool
+    {
+    private:
+        std::vector<std::thread> workers;
+        std::queue<job> pending;
+        std::mutex lock;
+        std::condition_variable available; // a job was submitted or the pool is closing
+        std::condition_variable idle; // every job submitted has finished
+        size_t running;
+        bool closing;
+
+        void work();
+    public:
+        job_pool(unsigned int threads);
+        job_pool(const job_pool&) = delete;
+        job_pool& operator=(const job_pool&) = delete;
+        void submit(job j);
+        void wait();
+        ~job_pool();
+    };
+}
+
+#endif
\ No newline at end of file
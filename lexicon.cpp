@@ -0,0 +1,30 @@
+#include <algorithm>
+
+#include "lexicon.h"
+
+namespace asc
+{
+    namespace lexicon
+    {
+        bool is_keyword(const char* text, size_t length)
+        {
+            return KEYWORD_TABLE.find(text, length) != -1;
+        }
+
+        bool is_punctuator(const char* text, size_t length)
+        {
+            return PUNCTUATOR_TABLE.find(text, length) != -1;
+        }
+
+        // Length of the longest punctuator at the start of the range, 0 if there is none
+        size_t match_punctuator(const char* begin, const char* end)
+        {
+            for (size_t length = std::min<size_t>(LONGEST_PUNCTUATOR, end - begin); length > 0; length--)
+            {
+                if (PUNCTUATOR_TABLE.find(begin, length) != -1)
+                    return length;
+            }
+            return 0;
+        }
+    }
+}
\ No newline at end of file
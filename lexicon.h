@@ -0,0 +1,172 @@
+#ifndef LEXICON_H
+#define LEXICON_H
+
+#include <cstddef>
+
+namespace asc
+{
+    // fixed vocabulary of A#, classified through perfect hash tables built by the compiler
+    namespace lexicon
+    {
+        constexpr const char* KEYWORDS[] = {
+            "void",
+            "byte",
+            "bool",
+            "char",
+            "short",
+            "int",
+            "long",
+            "real",
+            "signed",
+            "unsigned",
+            "return",
+            "public",
+            "private",
+            "protected",
+            "if",
+            "for",
+            "while",
+            "use",
+            "native",
+            "type",
+            "extends",
+            "object"
+        };
+
+        // longer punctuators come before the punctuators they start with, the regex tokenizer relies on it
+        constexpr const char* PUNCTUATORS[] = {
+            "&=",
+            "^=",
+            "|=",
+            "<<=",
+            ">>=",
+            "*=",
+            "/=",
+            "%=",
+            "+=",
+            "-=",
+            "||",
+            "&&",
+            "==",
+            "!=",
+            "~=",
+            "<<",
+            ">>",
+            "<=>",
+            "=>",
+            "<=",
+            ">=",
+            "<",
+            ">",
+            "|",
+            "^",
+            "&",
+            "!",
+            "~",
+            "++",
+            "--",
+            "+",
+            "->",
+            "-",
+            "*",
+            "/",
+            "%",
+            ".",
+            "[",
+            "]",
+            "::",
+            ",",
+            "{",
+            "}",
+            "(",
+            ")",
+            ";",
+            "?",
+            ":",
+            "="
+        };
+
+        const size_t KEYWORD_COUNT = sizeof(KEYWORDS) / sizeof(KEYWORDS[0]);
+        const size_t PUNCTUATOR_COUNT = sizeof(PUNCTUATORS) / sizeof(PUNCTUATORS[0]);
+        const size_t LONGEST_PUNCTUATOR = 3;
+
+        constexpr size_t length(const char* text)
+        {
+            size_t n = 0;
+            while (text[n] != '\0')
+                n++;
+            return n;
+        }
+
+        // FNV-1a salted with a seed
+        constexpr unsigned int hash(const char* text, size_t length, unsigned int seed)
+        {
+            unsigned int h = 2166136261u ^ seed;
+            for (size_t i = 0; i < length; i++)
+                h = (h ^ (unsigned char) text[i]) * 16777619u;
+            return h;
+        }
+
+        /**
+         * @brief Hash table over a fixed set of strings in which no two strings share a slot.
+         * The constructor searches for a seed under which the set hashes without collisions, so when the
+         * table is constexpr the search happens during compilation and a lookup is one hash and one comparison.
+         *
+         * @tparam SIZE Amount of slots, must be a power of two
+         */
+        template <size_t SIZE> class perfect_hash_table
+        {
+        public:
+            unsigned int seed;
+            short indices[SIZE]; // index of the string in each slot, -1 if the slot is empty
+            unsigned char lengths[SIZE];
+            const char* strings[SIZE];
+
+            constexpr perfect_hash_table(const char* const* entries, size_t count): seed(0), indices{}, lengths{}, strings{}
+            {
+                while (!place(entries, count))
+                    seed++;
+            }
+
+            // Places every entry into the slot the current seed hashes it to, false if two entries collide
+            constexpr bool place(const char* const* entries, size_t count)
+            {
+                for (size_t i = 0; i < SIZE; i++)
+                    indices[i] = -1;
+                for (size_t i = 0; i < count; i++)
+                {
+                    size_t slot = hash(entries[i], length(entries[i]), seed) & (SIZE - 1);
+                    if (indices[slot] != -1)
+                        return false;
+                    indices[slot] = i;
+                    lengths[slot] = length(entries[i]);
+                    strings[slot] = entries[i];
+                }
+                return true;
+            }
+
+            // Index of the string equal to the text, -1 if the text is not in the table
+            int find(const char* text, size_t length) const
+            {
+                size_t slot = hash(text, length, seed) & (SIZE - 1);
+                if (indices[slot] == -1 || lengths[slot] != length)
+                    return -1;
+                for (size_t i = 0; i < length; i++)
+                {
+                    if (strings[slot][i] != text[i])
+                        return -1;
+                }
+                return indices[slot];
+            }
+        };
+
+        constexpr perfect_hash_table<64> KEYWORD_TABLE(KEYWORDS, KEYWORD_COUNT);
+        constexpr perfect_hash_table<256> PUNCTUATOR_TABLE(PUNCTUATORS, PUNCTUATOR_COUNT);
+
+        bool is_keyword(const char* text, size_t length);
+        bool is_punctuator(const char* text, size_t length);
+        size_t match_punctuator(const char* begin, const char* end);
+    }
+}
+
+#endif
\ No newline at end of file
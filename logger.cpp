@@ -1,12 +1,15 @@
 #include <iostream>
+#include <atomic>
 
-#include "asc.h"
+#include "logger.h"
 
 namespace asc
 {
+    static std::atomic<bool> debugging(false); // set once from the command line, before anything is compiled
+
     void log(std::string& str, std::string&& descriptor)
     {
-        std::cout << "asc: " << descriptor << ": " << str << std::endl;
+        std::cout << "asc: " + descriptor + ": " + str + '\n' << std::flush; // one write, so lines logged by assembler jobs do not interleave
     }
 
     void gen(std::string& str)
@@ -61,7 +64,7 @@ namespace asc
 
     void debug(std::string& str)
     {
-        if (asc::has_option_set(asc::args, asc::cli_options::DEBUG))
+        if (debugging)
             log(str, "debug");
     }
 
@@ -69,4 +72,14 @@ namespace asc
     {
         debug(str);
     }
+
+    void enable_debug(bool enabled)
+    {
+        debugging = enabled;
+    }
+
+    bool debug_enabled()
+    {
+        return debugging;
+    }
 }
\ No newline at end of file
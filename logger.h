@@ -17,6 +17,8 @@ namespace asc
     void err(std::string&& str, int line);
     void debug(std::string& str);
     void debug(std::string&& str);
+    void enable_debug(bool enabled);
+    bool debug_enabled();
 }
 
 #endif
\ No newline at end of file
@@ -0,0 +1,97 @@
+#include <algorithm>
+#include <climits>
+#include <cstdlib>
+
+#include "module.h"
+
+namespace asc
+{
+    /* class module */
+
+    module::module(std::string path, std::string filepath)
+    {
+        this->path = path;
+        this->filepath = filepath;
+        this->state = module_states::UNCOMPILED;
+        this->hash = 0;
+        this->root = false;
+    }
+
+    // Records that this module uses another, an edge of the import graph
+    void module::import(module* used)
+    {
+        if (std::find(imports.begin(), imports.end(), used) == imports.end())
+            imports.push_back(used);
+    }
+
+    /* class module_registry */
+
+    // Finds the module of a file, adding it uncompiled the first time the file is required
+    module* module_registry::get(const std::string& filepath)
+    {
+        std::string path = normalize_path(filepath);
+        module*& m = by_path[path];
+        if (m == nullptr)
+        {
+            m = new module(path, filepath);
+            modules.push_back(m);
+        }
+        return m;
+    }
+
+    /**
+     * @brief Orders the modules so each one comes after every module it uses.
+     * Modules are visited in the order they were first required, so the order is the same on every run.
+     * A cycle cannot be ordered, its modules come in the order they were reached.
+     */
+    std::vector<module*> module_registry::build_order()
+    {
+        std::vector<module*> order;
+        std::unordered_map<module*, bool> visited;
+        std::vector<std::pair<module*, size_t>> pending; // module and the next of its imports to visit
+        for (module* root : modules)
+        {
+            if (visited[root])
+                continue;
+            visited[root] = true;
+            pending.push_back({ root, 0 });
+            while (!pending.empty())
+            {
+                std::pair<module*, size_t>& next = pending.back();
+                if (next.second == next.first->imports.size())
+                {
+                    order.push_back(next.first);
+                    pending.pop_back();
+                    continue;
+                }
+                module* used = next.first->imports[next.second++];
+                if (visited[used])
+                    continue;
+                visited[used] = true;
+                pending.push_back({ used, 0 });
+            }
+        }
+        return order;
+    }
+
+    module_registry::~module_registry()
+    {
+        for (module* m : modules)
+            delete m;
+    }
+
+    // Absolute path of a file, or the path as given when the file cannot be found
+    std::string normalize_path(const std::string& filepath)
+    {
+#ifdef _WIN32
+        char resolved[_MAX_PATH];
+        if (_fullpath(resolved, filepath.c_str(), _MAX_PATH) == nullptr)
+            return filepath;
+#else
+        char resolved[PATH_MAX];
+        if (realpath(filepath.c_str(), resolved) == nullptr)
+            return filepath;
+#endif
+        return resolved;
+    }
+}
\ No newline at end of file
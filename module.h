@@ -0,0 +1,70 @@
+#ifndef MODULE_H
+#define MODULE_H
+
+#include <string>
+#include <vector>
+#include <unordered_map>
+
+#include "interface.h"
+
+namespace asc
+{
+    typedef unsigned char module_state;
+
+    namespace module_states
+    {
+        const module_state UNCOMPILED = 0;
+        const module_state COMPILING = 1; // under way, a module using it again is part of a cycle
+        const module_state COMPILED = 2;
+        const module_state FAILED = 3;
+    }
+
+    /**
+     * @brief Source file compiled by this run of the compiler.
+     * Its exports are what it declares publicly, which each module using it declares as defined elsewhere.
+     * They are written to its interface file when it is compiled and read back from it when its last build is reused.
+     */
+    class module
+    {
+    public:
+        std::string path; // normalized, so one file reached through different paths is one module
+        std::string filepath; // path as it was first required by, for messages
+        module_state state;
+        unsigned long long hash; // content_hash of the source, 0 until it is read
+        bool root; // given on the command line, so compiled with an entry point
+        std::string rebuilt; // why it was compiled by this run, empty when its last build was up to date
+        std::vector<module*> imports; // modules it uses, in the order it first uses them
+        std::string object; // object file, empty until it is assembled
+        std::string interface; // interface file, empty until it is written
+        module_interface exports;
+
+        module(std::string path, std::string filepath);
+        module(const module&) = delete;
+        module& operator=(const module&) = delete;
+        void import(module* used);
+    };
+
+    /**
+     * @brief Every module of one run of the compiler, keyed by normalized path.
+     * Modules are kept in the order they were first required, and together with the imports of each
+     * they form the import graph, so modules which do not use one another can be told apart.
+     */
+    class module_registry
+    {
+    private:
+        std::unordered_map<std::string, module*> by_path;
+    public:
+        std::vector<module*> modules;
+
+        module_registry() = default;
+        module_registry(const module_registry&) = delete;
+        module_registry& operator=(const module_registry&) = delete;
+        module* get(const std::string& filepath);
+        std::vector<module*> build_order();
+        ~module_registry();
+    };
+
+    std::string normalize_path(const std::string& filepath);
+}
+
+#endif
\ No newline at end of file
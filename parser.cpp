@@ -6,7 +6,6 @@
 
 #include "parser.h"
 
-#define MAX_INT32 0x7FFFFFFF
 #define HEAP_PTR_IDENTIFIER "__HEAP_PTR"
 #define ASSUME_SIZE -1
 
@@ -14,211 +13,543 @@ namespace asc
 {
     class storage_register;
 
-    symbol* invalid_symbol = nullptr;
-
-    parser::parser(syntax_node* root)
+    parser::parser(compilation_context& ctx): ctx(ctx)
     {
-        this->current = root;
         this->scope = nullptr;
+        this->ns = nullptr;
         this->branchc = 0;
+        this->scopec = 0;
         this->slc = 0;
         this->fplc = 0;
         this->dpc = 0;
         this->dpm = 0;
         this->heap = false;
-        // add all standard types
-        for (auto& p : STANDARD_TYPES)
-            this->symbols[p.first].push_back(&(p.second));
+        this->mod = nullptr;
+        // add all standard types, made by each parser so no symbol is shared between compilations
+        for (const standard_type& type : STANDARD_TYPES)
+        {
+            type_symbol* sym = memory.make<type_symbol>(type.name, fully_qualified_type(), type.variant, visibilities::INVALID, type.size, nullptr, nullptr);
+            this->symbols.insert(sym->id, sym);
+        }
+    }
+
+    /**
+     * @brief Lowers a statement of the syntax tree to assembly
+     * @param node Statement to evaluate
+     * @return STATE_FOUND if the statement was evaluated, STATE_SYNTAX_ERROR if it is not valid
+     */
+    evaluation_state parser::eval(statement_node* node)
+    {
+        switch (node->kind)
+        {
+            case node_kinds::USE: return eval_use(static_cast<use_node*>(node));
+            case node_kinds::FUNCTION: return eval_function(static_cast<function_node*>(node));
+            case node_kinds::VARIABLE: return eval_var_declaration(static_cast<variable_node*>(node));
+            case node_kinds::TYPE: return eval_type_construct(static_cast<type_node*>(node));
+            case node_kinds::OBJECT: return eval_object_construct(static_cast<block_node*>(node));
+            case node_kinds::NAMESPACE: return eval_namespace(static_cast<block_node*>(node));
+            case node_kinds::IF: return eval_if_statement(static_cast<block_node*>(node));
+            case node_kinds::WHILE: return eval_while_statement(static_cast<block_node*>(node));
+            case node_kinds::RETURN: return eval_return_statement(static_cast<expression_statement*>(node));
+            case node_kinds::DELETE_STATEMENT: return eval_delete_statement(static_cast<expression_statement*>(node));
+            default: return eval_expression(static_cast<expression_statement*>(node)->expression);
+        }
     }
 
-    bool parser::parseable()
+    evaluation_state parser::eval_statements(statement_list& statements)
     {
-        return current != nullptr;
+        for (statement_node* statement : statements)
+        {
+            if (eval(statement) != STATE_FOUND)
+                return STATE_SYNTAX_ERROR;
+        }
+        return STATE_FOUND;
     }
 
     /**
-     * @brief Checks if the end of the file has been reached
-     * @param node Basis for the check
-     * @param silence Toggle if it shouldn't emit an error message
-     * @return Whether the end of the file has been reached based off of the syntax node provided
+     * @brief Declaration pass, makes the symbols of every function, global, type, object and namespace in the statements
+     * before any code is generated, so each of them can be used anywhere in the file instead of only after it.
+     * Declarations inside functions are left to be made when they are evaluated.
      */
-    bool parser::check_eof(syntax_node* node, bool silence)
+    evaluation_state parser::declare(statement_list& statements)
     {
-        if (node == nullptr)
+        for (statement_node* statement : statements)
         {
-            if (!silence)
-                asc::err("unexpected end of file");
-            return true;
+            evaluation_state state = STATE_FOUND;
+            switch (statement->kind)
+            {
+                case node_kinds::USE:
+                {
+                    use_node* use = static_cast<use_node*>(statement);
+                    state = use->declaration != nullptr ? declare_function(use->declaration) : declare_module(use);
+                    break;
+                }
+                case node_kinds::FUNCTION: state = declare_function(static_cast<function_node*>(statement)); break;
+                case node_kinds::VARIABLE: state = declare_global(static_cast<variable_node*>(statement)); break;
+                case node_kinds::TYPE: state = declare_type(static_cast<type_node*>(statement)); break;
+                case node_kinds::OBJECT: state = declare_object(static_cast<block_node*>(statement)); break;
+                case node_kinds::NAMESPACE:
+                {
+                    block_node* block = static_cast<block_node*>(statement);
+                    state = declare_namespace(block);
+                    if (state != STATE_FOUND)
+                        break;
+                    ns = declarations[block];
+                    state = declare(block->body);
+                    ns = ns->ns;
+                    break;
+                }
+            }
+            if (state != STATE_FOUND)
+                return STATE_SYNTAX_ERROR;
         }
-        return false;
+        return STATE_FOUND;
     }
 
-    evaluation_state parser::eval_function_header(syntax_node*& lcurrent, function_symbol*& result, bool use_declaration)
+    // Makes a function and its parameters, a function declared by a use statement is never defined so its parameters may be nameless
+    evaluation_state parser::declare_function(function_node* node)
     {
-        if (check_eof(lcurrent, true))
-            return STATE_NEUTRAL;
-        syntax_node* slcurrent = lcurrent;
-        // errors will be thrown later on once we CONFIRM this is supposed to be a function declaration
-        evaluation_state v_state = visibilities::value_of(asc::to_uppercase(*(slcurrent->value))) != visibilities::INVALID;
-        std::string v = "private"; // default to private
-        if (v_state == STATE_FOUND) // if a specifier was found, add it
-            v = *(slcurrent->value);
-        if (v_state == STATE_SYNTAX_ERROR)
+        bool use_declaration = node->use_declaration;
+        fully_qualified_type fqt;
+        if (eval_full_type(node->type, fqt) != STATE_FOUND)
             return STATE_SYNTAX_ERROR;
-        //asc::debug('v' << std::endl;
-        if (v_state != STATE_NEUTRAL)
+        if (symbol_table_get_imm(node->name) != nullptr)
         {
-            slcurrent = slcurrent->next;
-            if (check_eof(slcurrent, true))
-                return STATE_NEUTRAL;
+            asc::err("symbol is already defined", node->line);
+            return STATE_SYNTAX_ERROR;
         }
-        bool is_method = scope && scope->variant == symbol_variants::OBJECT;
-        type_symbol* obj = is_method ? dynamic_cast<type_symbol*>(scope) : nullptr;
-        int t_line = -1;
+        function_symbol* f_symbol = make_symbol<function_symbol>(lexeme(node->name), fqt, symbol_variants::FUNCTION,
+            node->vis, ns, scope, use_declaration);
+        symbol_table_insert(node->name, f_symbol);
+        declarations[node] = f_symbol;
+        int s = 8;
+        for (parameter_declaration& parameter : node->parameters)
+        {
+            fully_qualified_type afqt;
+            if (eval_full_type(parameter.type, afqt) != STATE_FOUND)
+                return STATE_SYNTAX_ERROR;
+            if (parameter.name == INVALID_LEXEME) // nameless argument of a function declared by a use statement
+            {
+                f_symbol->parameters.push_back(make_symbol<symbol>('_' + f_symbol->m_name + "_arg" + std::to_string(f_symbol->parameters.size()),
+                    afqt, symbol_variants::PARAMETER_VARIABLE, visibilities::PUBLIC, ns, static_cast<symbol*>(f_symbol)));
+                continue;
+            }
+            std::string a_identifier = lexeme(parameter.name);
+            if (f_symbol->get_parameter(a_identifier) != nullptr)
+            {
+                asc::err("symbol is already defined", parameter.line);
+                return STATE_SYNTAX_ERROR;
+            }
+            symbol* a_symbol = make_symbol<symbol>(a_identifier, afqt, symbol_variants::PARAMETER_VARIABLE,
+                visibilities::PUBLIC, ns, static_cast<symbol*>(f_symbol));
+            f_symbol->parameters.push_back(a_symbol);
+            a_symbol->offset = s += 8;
+        }
+        asc::debug("declared function: " + f_symbol->to_string());
+        return STATE_FOUND;
+    }
+
+    evaluation_state parser::declare_global(variable_node* node)
+    {
         fully_qualified_type fqt;
-        evaluation_state t_state = STATE_FOUND;
-        bool is_constructor = obj && *slcurrent == "_C" + obj->m_name;
-        if (!is_constructor)
+        if (eval_full_type(node->type, fqt) != STATE_FOUND)
+            return STATE_SYNTAX_ERROR;
+        if (symbol_table_get_imm(node->name) != nullptr) // symbol with this name already exists in this scope
         {
-            t_line = slcurrent->line;
-            t_state = eval_full_type(slcurrent, fqt);
-            if (t_state == STATE_NEUTRAL || t_state == STATE_SYNTAX_ERROR)
-                return t_state;
-            if (check_eof(slcurrent, true))
-                return STATE_NEUTRAL;
+            asc::err("symbol is already defined", node->line);
+            return STATE_SYNTAX_ERROR;
         }
-        else
+        symbol* sym = symbol_table_insert(node->name, make_symbol<symbol>(lexeme(node->name), fqt,
+            symbol_variants::GLOBAL_VARIABLE, node->vis, ns, scope));
+        sym->name_identified = true;
+        declarations[node] = sym;
+        return STATE_FOUND;
+    }
+
+    evaluation_state parser::declare_type(type_node* node)
+    {
+        type_symbol* sym = make_symbol<type_symbol>(lexeme(node->name), fully_qualified_type(), symbol_variants::STRUCTLIKE_TYPE,
+            node->vis, 0, ns, this->scope);
+        symbol_table_insert(node->name, sym);
+        declarations[node] = sym;
+        int overall_size = 0; // keep track of type's size
+        for (parameter_declaration& field : node->fields)
         {
-            if (!is_method)
-            {
-                asc::err("constructor defined outside of the scope of an object");
+            fully_qualified_type fqt;
+            if (eval_full_type(field.type, fqt) != STATE_FOUND)
                 return STATE_SYNTAX_ERROR;
-            }
-            fqt = symbol_table_get("_C" + obj->m_name)->fqt;
+            symbol* member_symbol = make_symbol<symbol>(lexeme(field.name), fqt, symbol_variants::STRUCTLIKE_TYPE_MEMBER,
+                visibilities::PUBLIC, ns, static_cast<symbol*>(sym));
+            sym->fields.push_back(member_symbol);
+            overall_size += fqt.base->get_size();
+        }
+        sym->size = overall_size; // update type's size with the size of its members
+        asc::debug("created type: " + sym->to_string());
+        return STATE_FOUND;
+    }
+
+    // Makes an object with its fields and methods, which are only put in scope while the object is evaluated
+    evaluation_state parser::declare_object(block_node* node)
+    {
+        type_symbol* sym = make_symbol<type_symbol>(lexeme(node->name), fully_qualified_type(), symbol_variants::OBJECT,
+            node->vis, 8, ns, this->scope);
+        symbol_table_insert(node->name, sym);
+        declarations[node] = sym;
+        // go through, define fields and methods and find the size of the type
+        for (statement_node* statement : node->body)
+        {
+            evaluation_state state = STATE_FOUND;
+            if (statement->kind == node_kinds::VARIABLE)
+                state = declare_object_field(static_cast<variable_node*>(statement), sym);
+            else if (statement->kind == node_kinds::FUNCTION)
+                state = declare_object_method(static_cast<function_node*>(statement), sym);
+            if (state == STATE_SYNTAX_ERROR)
+                return STATE_SYNTAX_ERROR;
+        }
+        return STATE_FOUND;
+    }
+
+    // Whether an object already has a field or method of the name
+    static bool has_member(type_symbol* obj, lexeme_id id)
+    {
+        for (symbol* field : obj->fields)
+        {
+            if (field->id == id)
+                return true;
+        }
+        for (function_symbol* method : obj->methods)
+        {
+            if (method->id == id)
+                return true;
         }
-        // at this point, it could still be a variable definition/declaration, so let's continue
-        int i_line = slcurrent->line;
-        std::string& identifier = *(slcurrent->value); // get the identifier that MIGHT be there
-        if (is_constructor) // constructor method
-            identifier = "_C" + scope->m_name;
-        //asc::debug('i' << std::endl;
-        slcurrent = slcurrent->next;
-        if (check_eof(slcurrent, true))
-            return STATE_NEUTRAL;
-        if (*(slcurrent->value) != "(") // if there is no parenthesis, it's confirmed that this is not a variable declaration
-            return STATE_NEUTRAL; // return a neutral state, indicating no change
-        lcurrent = slcurrent;
-        // now let's throw some errors
-        if (t_state == STATE_NEUTRAL) // if there was no type specifier, throw an error
+        return false;
+    }
+
+    evaluation_state parser::declare_object_field(variable_node* node, type_symbol* obj)
+    {
+        fully_qualified_type fqt;
+        if (eval_full_type(node->type, fqt) != STATE_FOUND)
+            return STATE_SYNTAX_ERROR;
+        if (has_member(obj, node->name))
         {
-            asc::err("type specifier expected", t_line);
+            asc::err("symbol is already defined", node->line);
             return STATE_SYNTAX_ERROR;
         }
-        if (!is_method && symbol_table_get_imm(identifier) != nullptr)
+        symbol* member_symbol = make_symbol<symbol>(lexeme(node->name), fqt, symbol_variants::STRUCTLIKE_TYPE_MEMBER,
+            visibilities::PUBLIC, ns, static_cast<symbol*>(obj));
+        obj->fields.push_back(member_symbol);
+        obj->size += fqt.base->get_size();
+        return STATE_FOUND;
+    }
+
+    evaluation_state parser::declare_object_method(function_node* node, type_symbol* obj)
+    {
+        bool is_constructor = node->constructor;
+        fully_qualified_type fqt;
+        if (!is_constructor)
+        {
+            if (eval_full_type(node->type, fqt) != STATE_FOUND)
+                return STATE_SYNTAX_ERROR;
+        }
+        else
+            fqt = { obj, 1 };
+        if (has_member(obj, node->name))
         {
-            asc::err("symbol is already defined");
+            asc::err("symbol is already defined", node->line);
             return STATE_SYNTAX_ERROR;
         }
-        function_symbol* f_symbol = is_method ? dynamic_cast<function_symbol*>(symbol_table_get(identifier)) :
-            dynamic_cast<function_symbol*>(symbol_table_insert(identifier, new asc::function_symbol(identifier, fqt,
-            symbol_variants::FUNCTION, visibilities::value_of(asc::to_uppercase(v)), ns, scope, use_declaration)));
-        result = f_symbol;
-        if (is_method && !is_constructor)
+        symbol* sobj = static_cast<symbol*>(obj);
+        function_symbol* f_symbol = make_symbol<function_symbol>(lexeme(node->name), fqt,
+            is_constructor ? symbol_variants::CONSTRUCTOR_METHOD : symbol_variants::METHOD, node->vis, ns, sobj, false);
+        obj->methods.push_back(f_symbol);
+        declarations[node] = f_symbol;
+        if (!is_constructor) // add this parameter for non-constructor methods
         {
-            symbol* that = f_symbol->get_parameter("this");
-            symbol_table_insert(that->m_name, that);
-            storage_register& stor = asc::get_register("rcx");
-            as.instruct(f_symbol->name(), "mov" + stor.instruction_suffix() + " qword [rbp + " +
-                std::to_string(that->offset) + "], " + stor.m_name);
+            symbol* that = make_symbol<symbol>("this", fully_qualified_type{ obj, 1 },
+                symbol_variants::PARAMETER_VARIABLE, visibilities::INVALID, ns, f_symbol);
+            f_symbol->parameters.push_back(that);
+            that->offset = 16;
         }
-        for (int c = is_method && !is_constructor ? 2 : 1, s = is_method && !is_constructor ? 16 : 8; true; c++) // loop until we're at the end of the declaration, this is an infinite loop to make code smoother
+        int s = is_constructor ? 8 : 16;
+        for (parameter_declaration& parameter : node->parameters)
         {
-            lcurrent = lcurrent->next; // first, the argument type
-            if (check_eof(lcurrent))
-                return STATE_SYNTAX_ERROR;
-            if (*(lcurrent->value) == ")") // if there are no more arguments, leave the loop
-                break;
-            int at_line = lcurrent->line;
             fully_qualified_type afqt;
-            evaluation_state at_state = eval_full_type(lcurrent, afqt);
-            if (at_state == STATE_SYNTAX_ERROR)
+            if (eval_full_type(parameter.type, afqt) != STATE_FOUND)
                 return STATE_SYNTAX_ERROR;
-            if (at_state == STATE_NEUTRAL) // if there was no type specifier, throw an error
+            std::string a_identifier = lexeme(parameter.name);
+            if (f_symbol->get_parameter(a_identifier) != nullptr)
             {
-                asc::err("type specifier expected for argument " + std::to_string(c), at_line);
+                asc::err("symbol is already defined", parameter.line);
                 return STATE_SYNTAX_ERROR;
             }
-            // second, the argument identifier
-            if (check_eof(lcurrent))
+            symbol* a_symbol = make_symbol<symbol>(a_identifier, afqt,
+                symbol_variants::PARAMETER_VARIABLE, visibilities::PUBLIC, ns, static_cast<symbol*>(f_symbol));
+            f_symbol->parameters.push_back(a_symbol);
+            a_symbol->offset = s += 8;
+        }
+        asc::debug("defined method in " + obj->m_name + ": " + f_symbol->to_string());
+        return STATE_FOUND;
+    }
+
+    evaluation_state parser::declare_namespace(block_node* node)
+    {
+        declarations[node] = symbol_table_insert(node->name, make_symbol<symbol>(lexeme(node->name), fully_qualified_type(),
+            symbol_variants::NAMESPACE, visibilities::INVALID, ns, scope));
+        return STATE_FOUND;
+    }
+
+    // Compiles a used module unless it already is, then declares what it exports as defined elsewhere
+    evaluation_state parser::declare_module(use_node* node)
+    {
+        std::string path = lexeme(node->path);
+        asc::unwrap(path);
+        module* used = asc::require_module(ctx, path, mod);
+        if (used == nullptr) // if compilation doesn't work for external module
+        {
+            asc::err("usage compilation of " + path + " failed", node->line);
+            return STATE_SYNTAX_ERROR;
+        }
+        declarations[node] = nullptr;
+        if (!imported.insert(used).second) // used before in this file
+            return STATE_FOUND;
+        return declare_interface(used->exports, node->line);
+    }
+
+    // Resolves a type of an interface the way eval_full_type resolves one written in the source
+    evaluation_state parser::eval_interface_type(const interface_type_ref& ref, module_interface& iface, int line, fully_qualified_type& fqt)
+    {
+        type_expression type;
+        type.name = intern(iface.strings[ref.name]);
+        type.pointer_level = ref.pointer_level;
+        type.line = line;
+        for (specifier s = 0; s < 32; s++)
+        {
+            if (ref.specifiers & (1u << s))
+                type.specifiers.insert(s);
+        }
+        return eval_full_type(type, fqt);
+    }
+
+    /**
+     * @brief Declares the namespaces, types, objects, globals and functions of a used module from its interface.
+     * Every type is made before any field, so a field may be of any type the module exports.
+     */
+    evaluation_state parser::declare_interface(module_interface& iface, int line)
+    {
+        std::vector<symbol*> namespaces;
+        auto ns_of = [&](unsigned int index) { return index == NO_NAMESPACE ? ns : namespaces[index - 1]; };
+        for (interface_namespace& record : iface.namespaces)
+        {
+            lexeme_id name = intern(iface.strings[record.name]);
+            symbol* existing = symbol_table_get_imm(name);
+            if (existing != nullptr && existing->variant == symbol_variants::NAMESPACE) // shared with the file using the module
+                namespaces.push_back(existing);
+            else
+                namespaces.push_back(symbol_table_insert(name, make_symbol<symbol>(iface.strings[record.name], fully_qualified_type(),
+                    symbol_variants::NAMESPACE, visibilities::INVALID, ns_of(record.ns), scope)));
+        }
+        std::vector<type_symbol*> types;
+        for (interface_type& record : iface.types)
+        {
+            lexeme_id name = intern(iface.strings[record.name]);
+            if (symbol_table_get_imm(name) != nullptr)
+            {
+                asc::err("symbol is already defined", line);
                 return STATE_SYNTAX_ERROR;
-            if (*lcurrent == "," || *lcurrent == ")") // nameless argument
+            }
+            type_symbol* sym = make_symbol<type_symbol>(iface.strings[record.name], fully_qualified_type(),
+                record.variant == symbol_variants::OBJECT ? symbol_variants::OBJECT : symbol_variants::STRUCTLIKE_TYPE,
+                visibilities::PUBLIC, record.size, ns_of(record.ns), scope);
+            symbol_table_insert(name, sym);
+            types.push_back(sym);
+        }
+        for (size_t i = 0; i < types.size(); i++)
+        {
+            for (unsigned int f = iface.types[i].first_field; f < iface.types[i].first_field + iface.types[i].fields; f++)
             {
-                if (use_declaration) // we're predefining it using a use statement
+                fully_qualified_type fqt;
+                if (eval_interface_type(iface.fields[f].type, iface, line, fqt) != STATE_FOUND)
+                    return STATE_SYNTAX_ERROR;
+                types[i]->fields.push_back(make_symbol<symbol>(iface.strings[iface.fields[f].name], fqt,
+                    symbol_variants::STRUCTLIKE_TYPE_MEMBER, visibilities::PUBLIC, types[i]->ns, static_cast<symbol*>(types[i])));
+            }
+        }
+        for (size_t i = 0; i < types.size(); i++) // sizes are all known now, so the fields have to land where the module put them
+        {
+            for (size_t f = 0; f < types[i]->fields.size(); f++)
+            {
+                if ((unsigned int) types[i]->calc_field_offset(types[i]->fields[f]) != iface.fields[iface.types[i].first_field + f].offset)
                 {
-                    f_symbol->parameters.push_back(new asc::symbol('_' + f_symbol->m_name + "_arg" + std::to_string(c - 1), afqt,
-                        symbol_variants::PARAMETER_VARIABLE, visibilities::PUBLIC, ns, static_cast<symbol*>(f_symbol)));
-                    if (*lcurrent == ")")
-                    {
-                        asc::debug("declared function with use: " + f_symbol->to_string());
-                        return STATE_FOUND;
-                    }
-                    continue;
+                    asc::err("layout of " + types[i]->m_name + " does not match the interface it was declared by", line);
+                    return STATE_SYNTAX_ERROR;
                 }
-                asc::err("nameless function arguments are not allowed", at_line);
+            }
+        }
+        for (interface_global& record : iface.globals)
+        {
+            lexeme_id name = intern(iface.strings[record.name]);
+            fully_qualified_type fqt;
+            if (eval_interface_type(record.type, iface, line, fqt) != STATE_FOUND)
+                return STATE_SYNTAX_ERROR;
+            if (symbol_table_get_imm(name) != nullptr)
+            {
+                asc::err("symbol is already defined", line);
                 return STATE_SYNTAX_ERROR;
             }
-            int ai_line = lcurrent->line;
-            std::string& a_identifier = *(lcurrent->value); // get the identifier that MIGHT be there
-            if (symbol_table_get_imm(a_identifier, f_symbol) != nullptr) // if symbol already exists in this scope
+            symbol* sym = symbol_table_insert(name, make_symbol<symbol>(iface.strings[record.name], fqt,
+                symbol_variants::GLOBAL_VARIABLE, visibilities::PUBLIC, ns_of(record.ns), scope));
+            sym->name_identified = true;
+            as.external(sym->m_name);
+        }
+        for (interface_function& record : iface.functions)
+        {
+            lexeme_id name = intern(iface.strings[record.name]);
+            fully_qualified_type fqt;
+            if (eval_interface_type(record.type, iface, line, fqt) != STATE_FOUND)
+                return STATE_SYNTAX_ERROR;
+            if (symbol_table_get_imm(name) != nullptr)
             {
-                asc::err("symbol is already defined", ai_line);
+                asc::err("symbol is already defined", line);
                 return STATE_SYNTAX_ERROR;
             }
-            symbol* a_symbol = is_method ? symbol_table_insert(a_identifier, f_symbol->get_parameter(a_identifier)) :
-                symbol_table_insert(a_identifier, new asc::symbol(a_identifier, afqt,
-                symbol_variants::PARAMETER_VARIABLE, visibilities::PUBLIC, ns, static_cast<symbol*>(f_symbol)));
-            if (!is_method)
+            function_symbol* f_symbol = make_symbol<function_symbol>(iface.strings[record.name], fqt, symbol_variants::FUNCTION,
+                visibilities::PUBLIC, ns_of(record.ns), scope, false);
+            symbol_table_insert(name, f_symbol);
+            int s = 8;
+            for (unsigned int p = record.first_parameter; p < record.first_parameter + record.parameters; p++)
             {
+                fully_qualified_type afqt;
+                if (eval_interface_type(iface.parameters[p].type, iface, line, afqt) != STATE_FOUND)
+                    return STATE_SYNTAX_ERROR;
+                symbol* a_symbol = make_symbol<symbol>(iface.strings[iface.parameters[p].name], afqt, symbol_variants::PARAMETER_VARIABLE,
+                    visibilities::PUBLIC, f_symbol->ns, static_cast<symbol*>(f_symbol));
                 f_symbol->parameters.push_back(a_symbol);
                 a_symbol->offset = s += 8;
             }
-            if (c <= 4 && !use_declaration)
+            as.external(f_symbol->m_name);
+            asc::debug("declared function from interface: " + f_symbol->to_string());
+        }
+        return STATE_FOUND;
+    }
+
+    // Whether a type means something to the files using the module, a primitive or a type the module exports
+    static bool exportable(const fully_qualified_type& fqt)
+    {
+        return fqt.base->is_primitive() || (fqt.base->vis == visibilities::PUBLIC && fqt.base->scope == nullptr);
+    }
+
+    static interface_type_ref export_type(const fully_qualified_type& fqt, module_interface& out)
+    {
+        unsigned int specifiers = 0;
+        for (specifier s : fqt.specifiers)
+            specifiers |= 1u << s;
+        return { out.string(fqt.base->m_name), (unsigned int) fqt.pointer_level, specifiers };
+    }
+
+    /**
+     * @brief Writes the public namespaces, types, objects, globals and functions of the statements into an interface
+     * for the files using the module, and makes the labels of the globals and functions global so those files link against them.
+     * Globals without a value have no label, and declarations of types the module does not export are left out.
+     * @param ns_index Namespace the statements are in, NO_NAMESPACE at the top of the file
+     */
+    void parser::export_interface(statement_list& statements, module_interface& out, unsigned int ns_index)
+    {
+        for (statement_node* statement : statements)
+        {
+            auto declared = declarations.find(statement);
+            if (declared == declarations.end() || declared->second == nullptr)
+                continue;
+            symbol* sym = declared->second;
+            if (statement->kind == node_kinds::NAMESPACE)
             {
-                storage_register& stor = asc::get_register(afqt.base->variant == symbol_variants::FLOATING_POINT_PRIMITIVE ?
-                    FP_ARG_REGISTER_SEQUENCE[c - 1] : ARG_REGISTER_SEQUENCE[c - 1]).byte_equivalent(afqt.base->get_size());
-                as.instruct(f_symbol->name(), "mov" + stor.instruction_suffix() + ' ' + afqt.base->word() + " [rbp + " +
-                    std::to_string(a_symbol->offset) + "], " + stor.m_name);
+                out.namespaces.push_back({ out.string(sym->m_name), ns_index });
+                export_interface(static_cast<block_node*>(statement)->body, out, out.namespaces.size());
+                continue;
             }
-            lcurrent = lcurrent->next; // lastly, what's next?
-            if (check_eof(lcurrent))
-                return STATE_SYNTAX_ERROR;
-            if (*(lcurrent->value) == ")") // if there are no more arguments, leave the loop
-                break;
-            if (*(lcurrent->value) != ",") // if there are more args and the next is not a comma
+            if (sym->vis != visibilities::PUBLIC)
+                continue;
+            switch (statement->kind)
             {
-                asc::err("unexpected end to argument listing", lcurrent->line);
-                return STATE_SYNTAX_ERROR;
+                case node_kinds::TYPE:
+                case node_kinds::OBJECT:
+                {
+                    type_symbol* t_sym = static_cast<type_symbol*>(sym);
+                    if (!std::all_of(t_sym->fields.begin(), t_sym->fields.end(), [](symbol* field) { return exportable(field->fqt); }))
+                        break;
+                    out.types.push_back({ out.string(t_sym->m_name), ns_index, t_sym->variant, (unsigned int) t_sym->size,
+                        (unsigned int) out.fields.size(), (unsigned int) t_sym->fields.size() });
+                    for (symbol* field : t_sym->fields)
+                        out.fields.push_back({ out.string(field->m_name), export_type(field->fqt, out), (unsigned int) t_sym->calc_field_offset(field) });
+                    break;
+                }
+                case node_kinds::VARIABLE:
+                {
+                    if (static_cast<variable_node*>(statement)->expression == nullptr || !exportable(sym->fqt))
+                        break;
+                    out.globals.push_back({ out.string(sym->m_name), ns_index, export_type(sym->fqt, out) });
+                    as.global(sym->m_name);
+                    break;
+                }
+                case node_kinds::FUNCTION:
+                {
+                    function_symbol* f_sym = static_cast<function_symbol*>(sym);
+                    if (f_sym->m_name == as.entry || !exportable(f_sym->fqt) ||
+                        !std::all_of(f_sym->parameters.begin(), f_sym->parameters.end(), [](symbol* parameter) { return exportable(parameter->fqt); }))
+                        break;
+                    out.functions.push_back({ out.string(f_sym->m_name), ns_index, export_type(f_sym->fqt, out),
+                        (unsigned int) out.parameters.size(), (unsigned int) f_sym->parameters.size() });
+                    for (symbol* parameter : f_sym->parameters)
+                        out.parameters.push_back({ out.string(parameter->m_name), export_type(parameter->fqt, out) });
+                    as.global(f_sym->m_name);
+                    break;
+                }
             }
         }
-        // after argument listing, scope into function if syntax is correct
-        lcurrent = lcurrent->next;
-        if (check_eof(lcurrent))
+    }
+
+    // Binds the parameters of a declared function and scopes into it, the first four arguments are moved from their registers to the stack
+    evaluation_state parser::eval_function_header(function_node* node, function_symbol*& result)
+    {
+        if (declarations.count(node) == 0 && declare_function(node) != STATE_FOUND) // declared inside a function
             return STATE_SYNTAX_ERROR;
-        if (*(lcurrent->value) != "{") // if the syntax is not right
+        function_symbol* f_symbol = static_cast<function_symbol*>(declarations[node]);
+        result = f_symbol;
+        if (node->use_declaration) // declared parameters are never in scope
         {
-            asc::err("expected a left curly brace to start function", lcurrent->line);
-            return STATE_SYNTAX_ERROR;
+            asc::debug("declared function with use: " + f_symbol->to_string());
+            return STATE_FOUND;
+        }
+        bool is_constructor = node->constructor;
+        bool is_method = f_symbol->variant != symbol_variants::FUNCTION;
+        type_symbol* obj = is_method ? static_cast<type_symbol*>(f_symbol->scope) : nullptr;
+        if (is_method && !is_constructor)
+        {
+            symbol* that = f_symbol->parameters[0];
+            symbol_table_insert(that->m_name, that);
+            storage_register& stor = asc::get_register("rcx");
+            as.instruct(f_symbol->name(), "mov" + stor.instruction_suffix() + " qword [rbp + " +
+                std::to_string(that->offset) + "], " + stor.m_name);
+        }
+        for (size_t c = is_method && !is_constructor ? 2 : 1; c <= f_symbol->parameters.size(); c++)
+        {
+            symbol* a_symbol = symbol_table_insert(f_symbol->parameters[c - 1]->id, f_symbol->parameters[c - 1]);
+            if (c <= 4)
+            {
+                type_symbol* base = a_symbol->fqt.base;
+                storage_register& stor = asc::get_register(base->variant == symbol_variants::FLOATING_POINT_PRIMITIVE ?
+                    FP_ARG_REGISTER_SEQUENCE[c - 1] : ARG_REGISTER_SEQUENCE[c - 1]).byte_equivalent(base->get_size());
+                as.instruct(f_symbol->name(), "mov" + stor.instruction_suffix() + ' ' + base->word() + " [rbp + " +
+                    std::to_string(a_symbol->offset) + "], " + stor.m_name);
+            }
         }
         scope = f_symbol; // scope into function
-        lcurrent = lcurrent->next; // move into the function
-        if (check_eof(lcurrent))
-            return STATE_SYNTAX_ERROR;
+        symbols.enter_scope(scope);
         if (is_constructor) // create memory for object
         {
-            symbol* that = symbol_table_insert("this", new asc::symbol("this", { obj, 1 },
+            symbol* that = symbol_table_insert("this", make_symbol<symbol>("this", fully_qualified_type{ obj, 1 },
                 symbol_variants::LOCAL_VARIABLE, visibilities::INVALID, ns, scope));
             that->offset = this->reserve_data_space(that->get_size());
-            push_emulation(that);
+            push_emulation(symbol_element(that));
             init_heap();
             as.instruct(scope->name(), "mov rcx, qword [" + std::string(HEAP_PTR_IDENTIFIER) + ']');
             as.instruct(scope->name(), "mov rdx, 8");
@@ -227,46 +558,27 @@ namespace asc
             as.instruct(scope->name(), "call HeapAlloc");
             as.instruct(scope->name(), "mov " + relative_dereference("rbp", that->offset) + ", rax");
         }
-        current = lcurrent; // move member current to its proper location
         asc::debug("defined function: " + f_symbol->to_string());
         return STATE_FOUND; // finally, return the proper state
     }
 
-    evaluation_state parser::eval_function_header()
+    evaluation_state parser::eval_function(function_node* node)
     {
-        syntax_node* current = this->current;
-        function_symbol* n = nullptr;
-        return eval_function_header(current, n, false);
+        function_symbol* f_symbol = nullptr;
+        if (eval_function_header(node, f_symbol) != STATE_FOUND || eval_statements(node->body) != STATE_FOUND)
+            return STATE_SYNTAX_ERROR;
+        return eval_block_ending();
     }
 
-    evaluation_state parser::eval_if_statement(syntax_node*& lcurrent)
+    evaluation_state parser::eval_if_statement(block_node* node)
     {
-        if (check_eof(lcurrent, true))
-            return STATE_NEUTRAL;
-        if (*(lcurrent->value) != "if") // not an if statement
-            return STATE_NEUTRAL;
-        lcurrent = lcurrent->next;
-        if (check_eof(lcurrent))
-            return STATE_SYNTAX_ERROR;
-        if (*(lcurrent->value) != "(")
-        {
-            asc::err("expected left parenthesis to start if statement");
-            return STATE_SYNTAX_ERROR;
-        }
-        evaluation_state ev_ex = eval_expression(lcurrent = lcurrent->next);
-        if (ev_ex == STATE_SYNTAX_ERROR)
-            return STATE_SYNTAX_ERROR;
-        if (ev_ex == STATE_NEUTRAL) // if there was no expression found
+        if (scope == nullptr)
         {
-            asc::err("expression expected");
+            asc::err("if statement outside of function", node->line);
             return STATE_SYNTAX_ERROR;
         }
-        lcurrent = lcurrent->next; // move past left parenthesis
-        //// TODO: ALLOW FOR ONE LINE IF STATEMENTS
-        if (check_eof(lcurrent))
+        if (eval_expression(node->condition) != STATE_FOUND)
             return STATE_SYNTAX_ERROR;
-        lcurrent = lcurrent->next; // move past left brace, and into the if statement
-        //// END TODO
         std::string ifbname = 'B' + std::to_string(++this->branchc); // if branch name
         std::string aftername = 'B' + std::to_string(++this->branchc); // after the if statement, plus split the current label
         as.instruct(scope->name(), "cmp rax, 0");       // if expression is not false
@@ -279,47 +591,23 @@ namespace asc
         asc::subroutine*& ifb = as.sr(ifbname, csr); // if block subroutine
         asc::subroutine*& aftb = as.sr(aftername, csr); // after if block subroutine
         ifb->ending = "jmp " + aftername; // setting ending of if block to be the jump to the after block
-        this->scope = new asc::symbol(ifbname, {}, symbol_variants::IF_BLOCK,
+        this->scope = make_symbol<symbol>(ifbname, fully_qualified_type(), symbol_variants::IF_BLOCK,
             visibilities::LOCAL, ns, this->scope); // move scope into if statement
-        current = lcurrent; // bring current up to speed
-        return STATE_FOUND;
-    }
-
-    evaluation_state parser::eval_if_statement()
-    {
-        asc::syntax_node* current = this->current;
-        return eval_if_statement(current);
+        symbols.enter_scope(scope);
+        if (eval_statements(node->body) != STATE_FOUND)
+            return STATE_SYNTAX_ERROR;
+        return eval_block_ending();
     }
 
-    evaluation_state parser::eval_while_statement(syntax_node*& lcurrent)
+    evaluation_state parser::eval_while_statement(block_node* node)
     {
-        if (check_eof(lcurrent, true))
-            return STATE_NEUTRAL;
-        if (*(lcurrent->value) != "while") // not a while loop
-            return STATE_NEUTRAL;
-        lcurrent = lcurrent->next;
-        if (check_eof(lcurrent))
-            return STATE_SYNTAX_ERROR;
-        if (*(lcurrent->value) != "(")
-        {
-            asc::err("expected left parenthesis to start while condition");
-            return STATE_SYNTAX_ERROR;
-        }
-        syntax_node* expression = (lcurrent = lcurrent->next);
-        evaluation_state ev_ex = eval_expression(lcurrent);
-        if (ev_ex == STATE_SYNTAX_ERROR)
-            return STATE_SYNTAX_ERROR;
-        if (ev_ex == STATE_NEUTRAL) // if there was no expression found
+        if (scope == nullptr)
         {
-            asc::err("expression expected");
+            asc::err("while loop outside of function", node->line);
             return STATE_SYNTAX_ERROR;
         }
-        lcurrent = lcurrent->next; // move past left parenthesis
-        //// TODO: ALLOW FOR ONE LINE WHILE LOOPS
-        if (check_eof(lcurrent))
+        if (eval_expression(node->condition) != STATE_FOUND)
             return STATE_SYNTAX_ERROR;
-        lcurrent = lcurrent->next; // move past left brace, and into the if statement
-        //// END TODO
         std::string loopbname = 'B' + std::to_string(++this->branchc); // if branch name
         std::string aftername = 'B' + std::to_string(++this->branchc); // after the if statement, plus split the current label
         as.instruct(scope->name(), "cmp rax, 0");       // if expression is not false
@@ -332,38 +620,18 @@ namespace asc
         asc::subroutine*& loopb = as.sr(loopbname, csr); // if block subroutine
         loopb->ending = ""; // no ending
         asc::subroutine*& aftb = as.sr(aftername, csr); // after if block subroutine
-        this->scope = new asc::symbol(loopbname, {}, symbol_variants::WHILE_BLOCK,
+        this->scope = make_symbol<symbol>(loopbname, fully_qualified_type(), symbol_variants::WHILE_BLOCK,
             visibilities::LOCAL, ns, this->scope); // move scope into while loop
-        this->scope->helper = expression; // preserve location of expression to be evaluated later
-        current = lcurrent; // bring current up to speed
-        return STATE_FOUND;
-    }
-
-    evaluation_state parser::eval_while_statement()
-    {
-        asc::syntax_node* current = this->current;
-        return eval_while_statement(current);
+        symbols.enter_scope(scope);
+        this->scope->condition = node->condition; // preserve the condition to be evaluated again at the end of the loop
+        if (eval_statements(node->body) != STATE_FOUND)
+            return STATE_SYNTAX_ERROR;
+        return eval_block_ending();
     }
 
-    evaluation_state parser::eval_block_ending(syntax_node*& lcurrent)
+    // Scopes out of the function, object, if statement or while loop whose statements were just evaluated
+    evaluation_state parser::eval_block_ending()
     {
-        if (check_eof(lcurrent, true))
-            return STATE_NEUTRAL;
-        if (*(lcurrent->value) != "}") // not a function ending
-            return STATE_NEUTRAL;
-        if (scope == nullptr) // if we're in the global scope
-        {
-            asc::err("attempting to scope out of the global scope", lcurrent->line);
-            return STATE_SYNTAX_ERROR;
-        }
-        if (ns && ns->scope == scope)
-        {
-            ns = ns->ns;
-            asc::debug("leaving namespace " + ns->to_string());
-            lcurrent = lcurrent->next;
-            current = lcurrent;
-            return STATE_FOUND;
-        }
         if (scope->variant == symbol_variants::CONSTRUCTOR_METHOD)
         {
             symbol* that = symbol_table_get("this");
@@ -374,41 +642,18 @@ namespace asc
             }
             as.instruct(scope->name(), "mov rax, " + relative_dereference("rbp", that->offset));
         }
-        for (auto it = symbols.begin(); it != symbols.end();)
-        // destroy all symbols in the current scope
-        {
-            auto& svp = *it;
-            svp.second.erase(std::remove_if(svp.second.begin(), svp.second.end(), [this](symbol* s)
-            {
-                if (s->scope == scope)
-                {
-                    asc::debug("scope out: deleted symbol " + s->name());
-                    return true;
-                }
-                return false;
-            }), svp.second.end());
-            if (svp.second.size() == 0)
-            {
-                symbols.erase(it++); // free up the memory from the vector
-                continue;
-            }
-            ++it;
-        }
+        symbols.exit_scope(scope); // destroy all symbols in the current scope
         if (symbol_variants::is_function_variant(scope->variant)) // if we're scoping out of a function
         {
             asc::debug("updating preserved for " + scope->m_name + ": " + std::to_string(dpm));
             as.sr(scope->m_name)->preserved_data = dpm; // set the max
             this->dpc = this->dpm = 0; // reset the dpc and dpm to be used later
+            stack_emulation.clear(); // locals of the function went with its frame, so the emulated stack stays as deep as one function needs
         }
         if (scope->variant == symbol_variants::WHILE_BLOCK)
         {
-            syntax_node*& cpy = scope->helper;
-            asc::evaluation_state es_ev = eval_expression(cpy);
-            if (es_ev != asc::STATE_FOUND) // how the hell...
-            {
-                asc::err("you are impressively bad at programming...", cpy->line);
+            if (eval_expression(scope->condition) != asc::STATE_FOUND)
                 return asc::STATE_SYNTAX_ERROR;
-            }
             as.instruct(scope->name(), "cmp rax, 0");
             as.instruct(scope->name(), "jne " + scope->name());
             as.instruct(scope->name(), "jmp B" + std::to_string(std::stoi(scope->name().substr(1)) + 1));
@@ -418,386 +663,167 @@ namespace asc
         else
             asc::debug("scoping out of " + scope->m_name + " into " + scope->scope->m_name);
         scope = scope->scope; // scope out of function
-        lcurrent = lcurrent->next;
-        current = lcurrent;
         return STATE_FOUND;
     }
 
-    evaluation_state parser::eval_block_ending()
-    {
-        syntax_node* current = this->current;
-        return eval_block_ending(current);
-    }
-
-    evaluation_state parser::eval_use(syntax_node*& lcurrent)
+    evaluation_state parser::eval_use(use_node* node)
     {
-        if (check_eof(lcurrent, true))
-            return STATE_NEUTRAL;
-        if (*(lcurrent->value) != "use") // not a use statement
-            return STATE_NEUTRAL; // neutral state indicating no change
-        lcurrent = lcurrent->next;
-        if (check_eof(lcurrent, true))
-            return STATE_NEUTRAL;
-        if (lcurrent->type == asc::syntax_types::KEYWORD) // eventual handling for native use statements
+        if (node->declaration != nullptr) // a function defined elsewhere
         {
-            if (*(lcurrent->value) == "native")
-            {
-                asc::err("unimplemented feature: native use statements", lcurrent->line);
+            function_symbol* result = nullptr;
+            if (eval_function_header(node->declaration, result) != STATE_FOUND)
                 return STATE_SYNTAX_ERROR;
-            }
-            else
-            {
-                function_symbol* result = nullptr;
-                auto header = eval_function_header(lcurrent, result, true);
-                if (header == STATE_SYNTAX_ERROR)
-                    return STATE_SYNTAX_ERROR;
-                if (header == STATE_NEUTRAL)
-                {
-                    asc::err("function declaration is incomplete", lcurrent->line);
-                    return STATE_SYNTAX_ERROR;
-                }
-                as.external(result->m_name);
-            }
-        }
-        else
-        {
-            std::string& path = asc::unwrap(*(lcurrent->value));
-            if (asc::compile(path) == -1) // if compilation doesn't work for external module
-            {
-                asc::err("usage compilation of " + path + " failed", lcurrent->line);
-                return STATE_SYNTAX_ERROR;
-            }
+            as.external(result->m_name);
+            return STATE_FOUND;
         }
-        lcurrent = lcurrent->next; // skip to semicolon
-        if (check_eof(lcurrent, true))
-            return STATE_NEUTRAL;
-        if (*(lcurrent->value) != ";") // if this isn't a semicolon
-        {
-            asc::err("expected a semicolon", lcurrent->line);
+        if (declarations.count(node) == 0 && declare_module(node) != STATE_FOUND)
             return STATE_SYNTAX_ERROR;
-        }
-        lcurrent = lcurrent->next; // go past semicolon
-        current = lcurrent; // sync up current
-        return STATE_FOUND; // return good state
-    }
-
-    evaluation_state parser::eval_use()
-    {
-        syntax_node* current = this->current;
-        return eval_use(current);
+        return STATE_FOUND;
     }
 
-    evaluation_state parser::eval_var_declaration(syntax_node*& lcurrent)
+    evaluation_state parser::eval_var_declaration(variable_node* node)
     {
-        syntax_node* slcurrent = lcurrent;
-        if (check_eof(slcurrent, true))
-            return STATE_NEUTRAL;
-        visibility v = scope && scope->variant != symbol_variants::OBJECT ? visibilities::LOCAL : visibilities::value_of(to_uppercase(*(slcurrent->value)));
-        if (v != visibilities::INVALID && v != visibilities::LOCAL)
-            slcurrent = slcurrent->next;
-        if (v == visibilities::INVALID)
-            v = visibilities::PRIVATE;
-        if (check_eof(slcurrent, true))
-            return STATE_NEUTRAL;
-        fully_qualified_type fqt;
-        auto t_state = eval_full_type(slcurrent, fqt);
-        if (t_state == STATE_NEUTRAL || t_state == STATE_SYNTAX_ERROR)
-            return t_state;
-        if (check_eof(slcurrent, true))
-            return STATE_NEUTRAL;
-        syntax_node* i_node = slcurrent; // copy identifier syntax node
-        int i_line = slcurrent->line;
-        std::string i = *(slcurrent->value);
-        if (check_eof(slcurrent = slcurrent->next, true))
-            return STATE_NEUTRAL;
-        bool arrayalloc = *(slcurrent->value) == "~=";
-        if (*(slcurrent->value) != "=" && *(slcurrent->value) != ";" && *(slcurrent->value) != "~=") // this is NOT a variable declaration (most likely a function declaration)
-            return STATE_NEUTRAL;
-        lcurrent = i_node; // sync up local with identifier node
         if (scope && scope->variant == symbol_variants::OBJECT) // instance and segregate variables are done thru the object eval method
         {
-            for (; !check_eof(lcurrent, true) && *lcurrent != ";"; lcurrent = lcurrent->next);
-            if (check_eof(lcurrent))
-                return STATE_SYNTAX_ERROR;
-            lcurrent = lcurrent->next;
-            current = lcurrent;
-            asc::debug("skipping variable declaration for " + i + " because it is already defined for object " + scope->name());
+            asc::debug("skipping variable declaration for " + lexeme(node->name) + " because it is already defined for object " + scope->name());
             return STATE_FOUND;
         }
-        if (symbol_table_get_imm(i) != nullptr) // symbol with this name already exists in this scope
+        if (scope == nullptr) // globals are declared before any code is generated
         {
-            asc::err("symbol is already defined", slcurrent->line);
-            return STATE_SYNTAX_ERROR;
+            if (declarations.count(node) == 0 && declare_global(node) != STATE_FOUND)
+                return STATE_SYNTAX_ERROR;
+            return eval_expression(node->expression);
         }
-        symbol* sym = symbol_table_insert(*(i_node->value), new asc::symbol(*(i_node->value), fqt,
-            (scope != nullptr ? symbol_variants::LOCAL_VARIABLE : symbol_variants::GLOBAL_VARIABLE), v, ns, scope));
-        if (scope != nullptr)
+        fully_qualified_type fqt;
+        if (eval_full_type(node->type, fqt) != STATE_FOUND)
+            return STATE_SYNTAX_ERROR;
+        if (symbol_table_get_imm(node->name) != nullptr) // symbol with this name already exists in this scope
         {
-            sym->offset = this->reserve_data_space(sym->get_size());
-            push_emulation(sym);
+            asc::err("symbol is already defined", node->line);
+            return STATE_SYNTAX_ERROR;
         }
-        else
-            sym->name_identified = true;
-        return eval_expression(lcurrent);
+        symbol* sym = symbol_table_insert(node->name, make_symbol<symbol>(lexeme(node->name), fqt,
+            symbol_variants::LOCAL_VARIABLE, node->vis, ns, scope));
+        sym->offset = this->reserve_data_space(sym->get_size());
+        push_emulation(symbol_element(sym));
+        return eval_expression(node->expression);
     }
 
-    evaluation_state parser::eval_var_declaration()
+    // Node of an expression tree being flattened, its element is output once the children it takes are
+    typedef struct flatten_frame
     {
-        syntax_node* current = this->current;
-        return eval_var_declaration(current);
-    }
+        expression_node* node;
+        rpn_element element;
+        size_t next; // children output so far
+    } flatten_frame;
 
-    evaluation_state parser::eval_expression(syntax_node*& lcurrent)
+    /**
+     * @brief Flattens an expression tree into the postfix order the code generator consumes.
+     * The arguments of a call come last to first, so the first argument ends up on top of the emulated stack.
+     * The tree is walked with a stack of its own, a chain of operators can be as long as the source makes it.
+     */
+    evaluation_state parser::flatten_expression(expression_node* node, std::deque<rpn_element>& output)
     {
-        std::deque<rpn_element> output;
-        std::stack<expression_operator> operators;
-
-        std::stack<function_symbol*> functions;
-        std::stack<int> call_indices;
-        bool call_start = false;
-        bool skip_next = false;
-
-        // shunting-yard algorithm: https://en.wikipedia.org/wiki/Shunting-yard_algorithm
-        for (syntax_node* previous_node = nullptr; *lcurrent != ";";)
+        std::vector<flatten_frame> frames;
+        frames.push_back({ node, {}, 0 });
+        if (flatten_element(node, nullptr, frames.back().element) != STATE_FOUND)
+            return STATE_SYNTAX_ERROR;
+        while (!frames.empty())
         {
-            if (lcurrent == nullptr)
-            {
-                if (!output.empty() || !operators.empty())
-                {
-                    asc::err("unexpected end of expression");
-                    return STATE_SYNTAX_ERROR;
-                }
-                return STATE_NEUTRAL;
-            }
-            std::string& value = *(lcurrent->value);
-            // literals
-            if (is_numerical(value))
-            {
-                output.push_back({ value, nullptr, !call_indices.empty() ? call_indices.top() : -1,
-                    !functions.empty() ? functions.top() : nullptr, call_start ? !(call_start = false) : call_start });
-            }
-            // operators
-            else if (OPERATORS.count(value))
+            flatten_frame& frame = frames.back();
+            expression_node* parent = frame.node;
+            size_t count = parent->kind == node_kinds::OPERATION || parent->kind == node_kinds::CALL ? parent->children.size() : 0;
+            if (frame.next == count)
             {
-                expression_operator oper = OPERATORS[value];
-
-                int operands = 2;
-                char c_fix = 'i';
-
-                // manual prefix check
-                if (previous_node == nullptr || *previous_node == "(" || OPERATORS.count(*(previous_node->value)))
-                {
-                    c_fix = 'p';
-                    operands = 1;
-                }
-
-                // manual suffix check
-                if (lcurrent->next == nullptr || *(lcurrent->next) == ")" || OPERATORS.count(*(lcurrent->next->value)))
-                {
-                    c_fix = 's';
-                    operands = 1;
-                }
-
-                if (OPERATORS.count(value + std::to_string(operands) + c_fix))
-                    oper = OPERATORS[value + std::to_string(operands) + c_fix];
-
-                while (!operators.empty() && operators.top().value != "(" && (operators.top().precedence > oper.precedence ||
-                    (operators.top().precedence == oper.precedence && oper.association)))
-                {
-                    output.push_back({ operators.top().value, &oper,
-                        !call_indices.empty() ? call_indices.top() : -1,
-                        !functions.empty() ? functions.top() : nullptr,
-                        call_start ? !(call_start = false) : call_start });
-                    operators.pop();
-                }
-
-                if (oper.value == "," && !call_indices.empty()) // if it's a comma
-                    call_indices.top()++; // add one to the index
-
-                if (!oper.helper)
-                    operators.push(oper);
-            }
-            // functions
-            else if (lcurrent->next != nullptr && *(lcurrent->next) == "(")
-            {
-                call_indices.push(0);
-                auto* sym = symbol_table_get(*(lcurrent->value));
-                if (!sym)
-                {
-                    if (output.empty())
-                    {
-                        asc::err("function or method not defined");
-                        return STATE_SYNTAX_ERROR;
-                    }
-                    auto* inst = symbol_table_get(output.back().value);
-                    if (!inst)
-                    {
-                        asc::err("function or method not defined");
-                        return STATE_SYNTAX_ERROR;
-                    }
-                    auto* obj = inst->fqt.base;
-                    if (!obj)
-                    {
-                        asc::err("function or method not defined");
-                        return STATE_SYNTAX_ERROR;
-                    }
-                    auto* m = obj->get_method(*(lcurrent->value));
-                    if (operators.empty() || operators.top().value != "." || !m)
-                    {
-                        asc::err("function or method not defined");
-                        return STATE_SYNTAX_ERROR;
-                    }
-                    sym = m;
-                }
-                auto* f_sym = dynamic_cast<function_symbol*>(sym);
-                auto* t_sym = dynamic_cast<type_symbol*>(sym);
-                std::cout << *(lcurrent->value) << ", " << (sym ? sym->to_string() : "null") << std::endl;
-                if (t_sym)
-                {
-                    f_sym = dynamic_cast<function_symbol*>(symbol_table_get("_C" + t_sym->m_name));
-                    if (!f_sym)
-                    {
-                        f_sym = dynamic_cast<function_symbol*>(symbol_table_insert("_C" + t_sym->m_name,
-                            new function_symbol("_C" + t_sym->m_name, { t_sym, 1 }, symbol_variants::CONSTRUCTOR_METHOD,
-                            t_sym->vis, t_sym->ns, t_sym->scope, false)));
-                        for (auto* member : t_sym->fields)
-                            f_sym->parameters.push_back(member);
-                        asc::debug("created implicit constructor for " + t_sym->m_name + ": " + f_sym->to_string());
-                    }
-                }
-                if (!f_sym)
-                {
-                    asc::err("function or method not defined");
-                    return STATE_SYNTAX_ERROR;
-                }
-                functions.push(f_sym);
-                operators.push({ f_sym->m_name, 0, 2, LEFT_OPERATOR_ASSOCATION, INFIX_OPERATOR, false, true });
-                call_start = true;
-            }
-            // left paren
-            else if (*(lcurrent) == "(")
-                operators.push({ *(lcurrent->value), 0, 2, LEFT_OPERATOR_ASSOCATION, INFIX_OPERATOR });
-            // right paren
-            else if (*(lcurrent) == ")")
-            {
-                while (true)
-                {
-                    if (operators.empty())
-                    {
-                        asc::err("closing parenthesis with no opening", lcurrent->line);
-                        return STATE_SYNTAX_ERROR;
-                    }
-                    if (operators.top().value == "(") break;
-                    output.push_back({ operators.top().value, nullptr,
-                        !call_indices.empty() ? call_indices.top() : -1,
-                        !functions.empty() ? functions.top() : nullptr,
-                        call_start ? !(call_start = false) : call_start });
-                    operators.pop();
-                }
-                if (operators.empty() || operators.top().value != "(")
-                {
-                    asc::err("opening parenthesis expected", lcurrent->line);
-                    return STATE_SYNTAX_ERROR;
-                }
-                operators.pop();
-                if (!operators.empty() && operators.top().function)
-                {
-                    call_indices.pop();
-                    functions.pop();
-                    output.push_back({ operators.top().value, nullptr,
-                        !call_indices.empty() ? call_indices.top() : -1,
-                        !functions.empty() ? functions.top() : nullptr,
-                        call_start ? !(call_start = false) : call_start });
-                    operators.pop();
-                }
-            }
-            // anything else
-            else
-            {
-                fully_qualified_type fqt;
-                eval_full_type(lcurrent, fqt);
-                if (fqt.base) skip_next = true;
-                output.push_back({ fqt.base ? fqt.base->m_name : *(lcurrent->value), nullptr,
-                    !call_indices.empty() ? call_indices.top() : -1,
-                    !functions.empty() ? functions.top() : nullptr,
-                    call_start ? !(call_start = false) : call_start });
+                output.push_back(frame.element);
+                frames.pop_back();
+                continue;
             }
-            previous_node = lcurrent;
-            if (!skip_next)
-                lcurrent = lcurrent->next;
-            skip_next = false;
-        }
-
-        while (!operators.empty())
-        {
-            if (operators.top().value == "(")
-            {
-                asc::err("left parenthesis invalid");
+            size_t i = frame.next++;
+            expression_node* child = parent->kind == node_kinds::CALL ? parent->children[count - 1 - i] : parent->children[i];
+            expression_node* receiver = parent->value == lexemes::DOT && parent->kind == node_kinds::OPERATION && i != 0 ?
+                parent->children[0] : nullptr;
+            frames.push_back({ child, {}, 0 });
+            if (flatten_element(child, receiver, frames.back().element) != STATE_FOUND)
                 return STATE_SYNTAX_ERROR;
-            }
-            output.push_back({ operators.top().value, nullptr,
-                !call_indices.empty() ? call_indices.top() : -1,
-                !functions.empty() ? functions.top() : nullptr,
-                call_start ? !(call_start = false) : call_start });
-            operators.pop();
         }
-        
-        lcurrent = lcurrent->next; // skip over the semicolon which denoted the end of the expression
-        current = lcurrent; // sync up our local current with the object member
+        return STATE_FOUND;
+    }
 
+    /**
+     * @brief Makes the element a node of an expression tree is output as, resolving the type or function it names
+     * @param receiver Left hand side of the dot operator when the node is a method call
+     */
+    evaluation_state parser::flatten_element(expression_node* node, expression_node* receiver, rpn_element& element)
+    {
+        element = { node->value, node->oper, -1, nullptr, false };
+        if (node->kind == node_kinds::TYPE_NAME)
         {
-            std::string db = "shunting-yard:\n";
-            for (auto& it : output)
-                db += it.value + " (parameter index: " + std::to_string(it.parameter_index) + ", function: " + (it.function == nullptr ? "none" : it.function->m_name) + ")\n";
-                //db += it.value + ' ';
-            asc::debug(db);
-        }
-
-        // reverse function call parameters
-        for (auto it = output.begin(); it != output.end(); it++)
+            fully_qualified_type fqt;
+            if (eval_full_type(node->type, fqt) != STATE_FOUND)
+                return STATE_SYNTAX_ERROR;
+            element.value = fqt.base->id;
+        }
+        else if (node->kind == node_kinds::CALL)
         {
-            symbol* sym = symbol_table_get(it->value);
-            if (sym != nullptr && symbol_variants::is_function_variant(sym->variant))
+            symbol* sym = symbol_table_get(node->value);
+            if (!sym && receiver != nullptr && receiver->kind == node_kinds::NAME)
             {
-                auto call = it--;
-                auto* f_sym = dynamic_cast<function_symbol*>(sym);
-                std::deque<rpn_element> replacement;
-                int parameter_count = it->function ? it->parameter_index + 1 : 0;
-                if (!f_sym->external_decl && f_sym->parameters.size() != parameter_count)
-                {
-                    asc::err("function " + f_sym->m_name + " expected " +
-                        std::to_string(f_sym->parameters.size()) + " parameter(s), got " +
-                        std::to_string(parameter_count));
-                    return STATE_SYNTAX_ERROR;
-                }
-                // find supposed parameter count for external functions
-                for (int i = 0, last = parameter_count - 1; i < parameter_count; i++)
+                symbol* inst = symbol_table_get(receiver->value);
+                if (inst && inst->fqt.base)
+                    sym = inst->fqt.base->get_method(lexeme(node->value));
+            }
+            if (!sym)
+            {
+                asc::err("function or method not defined", node->line);
+                return STATE_SYNTAX_ERROR;
+            }
+            auto* f_sym = dynamic_cast<function_symbol*>(sym);
+            auto* t_sym = dynamic_cast<type_symbol*>(sym);
+            std::cout << lexeme(node->value) << ", " << sym->to_string() << std::endl;
+            if (t_sym)
+            {
+                f_sym = dynamic_cast<function_symbol*>(symbol_table_get("_C" + t_sym->m_name));
+                if (!f_sym)
                 {
-                    std::stack<rpn_element> storage;
-                    for (; it->parameter_index == last || it->function != f_sym; it--)
-                    {
-                        storage.push(*it);
-                        if (it->call_start && it->function == f_sym)
-                        {
-                            it--;
-                            break;
-                        }
-                    }
-                    last = it < output.begin() || it >= output.end() ? -1 : it->parameter_index;
-                    for (; !storage.empty(); storage.pop())
-                        replacement.push_back(storage.top());
+                    f_sym = dynamic_cast<function_symbol*>(symbol_table_insert("_C" + t_sym->m_name,
+                        make_symbol<function_symbol>("_C" + t_sym->m_name, fully_qualified_type{ t_sym, 1 }, symbol_variants::CONSTRUCTOR_METHOD,
+                        t_sym->vis, t_sym->ns, t_sym->scope, false)));
+                    for (auto* member : t_sym->fields)
+                        f_sym->parameters.push_back(member);
+                    asc::debug("created implicit constructor for " + t_sym->m_name + ": " + f_sym->to_string());
                 }
-                it = output.erase(it + 1, call);
-                it = output.insert(it, replacement.begin(), replacement.end());
-                it += replacement.size();
             }
+            if (!f_sym)
+            {
+                asc::err("function or method not defined", node->line);
+                return STATE_SYNTAX_ERROR;
+            }
+            // methods are passed the object they are called on as well
+            size_t parameter_count = node->children.size() + (f_sym->variant == symbol_variants::METHOD ? 1 : 0);
+            if (!f_sym->external_decl && f_sym->parameters.size() != parameter_count)
+            {
+                asc::err("function " + f_sym->m_name + " expected " +
+                    std::to_string(f_sym->parameters.size()) + " parameter(s), got " +
+                    std::to_string(parameter_count), node->line);
+                return STATE_SYNTAX_ERROR;
+            }
+            element.value = f_sym->id;
+            element.function = f_sym;
         }
+        return STATE_FOUND;
+    }
+
+    evaluation_state parser::eval_expression(expression_node* node)
+    {
+        std::deque<rpn_element> output;
+        if (node != nullptr && flatten_expression(node, output) != STATE_FOUND)
+            return STATE_SYNTAX_ERROR;
 
         {
-            std::string db = "shunting-yard + reverse function call:\n";
+            std::string db = "postfix expression: ";
             for (auto& it : output)
-                //db += it.value + " (parameter index: " + std::to_string(it.parameter_index) + ", function: " + (it.function == nullptr ? "none" : it.function->m_name) + ")\n";
-                db += it.value + ' ';
+                db += lexeme(it.value) + ' ';
             asc::debug(db);
         }
 
@@ -808,14 +834,13 @@ namespace asc
             for (; !output.empty(); output.pop_front())
             {
                 auto* element = &(output.front());
-                std::string* token = &(element->value);
-                symbol* sym = symbol_table_get(*token);
-                if (OPERATORS.count(*token)) // operator
+                const std::string* token = &lexeme(element->value);
+                symbol* sym = symbol_table_get(element->value);
+                if (element->oper != operators::NONE) // operator
                 {
-                    auto& oper = OPERATORS[*token];
-                    if (oper.value == "+")
+                    switch (element->oper)
                     {
-                        if (oper.operands == 2)
+                        case operators::ADDITION:
                         {
                             auto rhs = run.top();
                             run.pop();
@@ -846,11 +871,9 @@ namespace asc
                                 else if (flhs && frhs)
                                     run.push(std::to_string(std::stod(lhs) + std::stod(rhs)));
                             }
+                            break;
                         }
-                    }
-                    else if (oper.value == "=")
-                    {
-                        if (oper.operands == 2)
+                        case operators::ASSIGNMENT:
                         {
                             auto value = run.top();
                             run.pop();
@@ -870,7 +893,10 @@ namespace asc
                             else if (s->fqt.base->size == 8)
                                 sz = 'q';
                             as << asc::data << identifier + " d" + sz + ' ' + value + (nt ? ", 0x00" : "");
+                            break;
                         }
+                        default: // only sums and assignments are folded
+                            break;
                     }
                 }
                 else if (is_string_literal(*token))
@@ -900,28 +926,27 @@ namespace asc
 
         for (auto it = output.begin(); it != output.end(); it++)
         {
-            { // expression evaluation state checkup
+            if (asc::debug_enabled()) // expression evaluation state checkup, which is costly to build
+            {
                 std::string db = "-- current expression parse iteration --\n - expression: ";
                 for (auto& it : output)
                     //db += it.value + " (parameter index: " + std::to_string(it.parameter_index) + ", function: " + (it.function == nullptr ? "none" : it.function->m_name) + ")\n";
-                    db += it.value + ' ';
+                    db += lexeme(it.value) + ' ';
                 db += "\n - stack emulation: ";
                 for (auto& element : stack_emulation)
-                    db += element->to_string() + ' ';
+                    db += element.to_string() + ' ';
                 db += "\n - stack height: " + std::to_string(dpc);
                 asc::debug(db);
             }
             auto* element = &*it;
-            std::string* token = &(element->value);
-            symbol* sym = symbol_table_get(*token);
+            const std::string* token = &lexeme(element->value);
+            symbol* sym = symbol_table_get(element->value);
             asc::debug(*token + ", " + (sym ? sym->to_string() : "no symbol associated"));
-            if (OPERATORS.count(*token)) // operator
+            if (element->oper != operators::NONE) // operator
             {
-                auto& oper = OPERATORS[*token];
-                // addition operator
-                if (oper.value == "+")
+                switch (element->oper)
                 {
-                    if (oper.operands == 2)
+                    case operators::ADDITION: // addition operator
                     {
                         symbol* fpl = floating_point_stack();
                         auto& first = retrieve_stack_value(get_register(fpl ? "xmm5" : "rbx"));
@@ -929,12 +954,9 @@ namespace asc
                         as.instruct(scope->name(), "add" + (fpl != nullptr ? fpl->instruction_suffix() : "") + ' ' + second.m_name + ", " + first.m_name);
                         preserve_value(second, fpl ? fpl->get_size() : ASSUME_SIZE);
                         (it = output.erase(it))--;
+                        break;
                     }
-                }
-                // subtraction operator
-                if (oper.value == "-")
-                {
-                    if (oper.operands == 2)
+                    case operators::SUBTRACTION: // subtraction operator
                     {
                         symbol* fpl = floating_point_stack();
                         auto& first = retrieve_stack_value(get_register(fpl ? "xmm5" : "rbx"));
@@ -942,12 +964,9 @@ namespace asc
                         as.instruct(scope->name(), "sub" + (fpl != nullptr ? fpl->instruction_suffix() : "") + ' ' + second.m_name + ", " + first.m_name);
                         preserve_value(second, fpl ? fpl->get_size() : ASSUME_SIZE);
                         (it = output.erase(it))--;
+                        break;
                     }
-                }
-                // multiplication and pointer operator
-                if (oper.value == "*")
-                {
-                    if (oper.operands == 2)
+                    case operators::MULTIPLICATION: // multiplication operator
                     {
                         symbol* fpl = floating_point_stack();
                         auto& first = retrieve_stack_value(get_register(fpl ? "xmm5" : "rbx"));
@@ -956,17 +975,15 @@ namespace asc
                             (fpl != nullptr ? fpl->instruction_suffix() : "") + ' ' + second.m_name + ", " + first.m_name);
                         preserve_value(second, fpl ? fpl->get_size() : second.get_size());
                         (it = output.erase(it))--;
+                        break;
                     }
-                    if (oper.operands == 1)
+                    case operators::DEREFERENCE: // pointer operator
                     {
                         asc::err("pointers have not been implemented yet");
                         return STATE_SYNTAX_ERROR;
+                        break;
                     }
-                }
-                // division operator
-                if (oper.value == "/")
-                {
-                    if (oper.operands == 2)
+                    case operators::DIVISION: // division operator
                     {
                         symbol* fpl = floating_point_stack();
                         auto& first = retrieve_stack_value(get_register(fpl ? "xmm5" : "rbx"));
@@ -985,12 +1002,9 @@ namespace asc
                                 fpl ? fpl->get_size() : -1);
                         }
                         (it = output.erase(it))--;
+                        break;
                     }
-                }
-                // division operator
-                if (oper.value == "%")
-                {
-                    if (oper.operands == 2)
+                    case operators::MODULO: // modulo operator
                     {
                         auto& first = retrieve_stack_value(get_register("rbx"));
                         auto& second = retrieve_stack_value(get_register("rax"));
@@ -1000,62 +1014,57 @@ namespace asc
                         preserve_value(first.get_size() != 1 ? get_register("rdx").byte_equivalent(second.get_size())
                             : get_register("ah"));
                         (it = output.erase(it))--;
+                        break;
                     }
-                }
-                // assignment operator
-                if (oper.value == "=")
-                {
-                    if (oper.operands == 2)
+                    case operators::ASSIGNMENT: // assignment operator
                     {
                         int fz = 0;
                         if (!stack_emulation.empty())
                         {
-                            auto* t = top_emulation();
-                            symbol* s = dynamic_cast<symbol*>(t);
-                            reference_element* rdest = dynamic_cast<reference_element*>(t);
-                            fp_register* fp_reg = dynamic_cast<fp_register*>(t);
-                            if (s != nullptr && s->fqt.base->variant == symbol_variants::FLOATING_POINT_PRIMITIVE)
-                                fz = s->get_size();
-                            else if (fp_reg != nullptr)
-                                fz = fp_reg->effective_sizes.top();
-                            else if (rdest && rdest->fp && !rdest->fqt.pointer_level)
-                                fz = rdest->get_size();
+                            emulated_element& t = stack_emulation.back();
+                            if (t.fp && (t.kind == element_kinds::SYMBOL || (t.kind == element_kinds::REFERENCE && !t.pointer_level)))
+                                fz = t.get_size();
+                            else if (t.fp && t.kind == element_kinds::REGISTER)
+                                fz = t.size;
                         }
                         auto& src = retrieve_stack_value(get_register(fz ? "xmm4" : "rax"));
-                        reference_element* re_dest = dynamic_cast<reference_element*>(top_emulation());
-                        symbol* s_dest = dynamic_cast<symbol*>(top_emulation());
+                        if (stack_emulation.empty() ||
+                            (top_emulation()->kind != element_kinds::SYMBOL && top_emulation()->kind != element_kinds::REFERENCE))
+                        {
+                            asc::err("destination for assignment must be a symbol or array element reference");
+                            return STATE_SYNTAX_ERROR;
+                        }
+                        emulated_element dest = *top_emulation();
+                        bool re_dest = dest.kind == element_kinds::REFERENCE;
                         if (re_dest)
                             retrieve_stack(get_register("rbx"));
                         else
                             forget_top();
-                        std::cout << s_dest << ", " << re_dest << std::endl;
+                        std::cout << (re_dest ? nullptr : dest.sym) << ", " << (re_dest ? &dest : nullptr) << std::endl;
                         std::cout << scope << ", " << fz << ", " << src.m_name << std::endl;
                         as.instruct(scope->name(), "mov" + (fz ? std::string("s") + (fz == 8 ? 'd' : 's') : "")
-                            + ' ' + (re_dest ? re_dest->word() + " [rbx]" :
-                            relative_dereference("rbp", s_dest->offset, s_dest->word())) + ", " + src.m_name);
+                            + ' ' + (re_dest ? dest.word() + " [rbx]" :
+                            relative_dereference("rbp", dest.sym->offset, dest.word())) + ", " + src.m_name);
                         preserve_value(src, fz ? fz : -1);
                         (it = output.erase(it))--;
+                        break;
                     }
-                }
-                // allocation operator
-                if (oper.value == "~=")
-                {
-                    if (oper.operands == 2)
+                    case operators::ALLOCATION: // allocation operator
                     {
                         init_heap();
                         as.instruct(scope->name(), "mov rcx, qword [" + std::string(HEAP_PTR_IDENTIFIER) + ']');
                         as.instruct(scope->name(), "mov rdx, 8");
                         retrieve_stack_value(get_register("r8"));
-                        auto* dest_s = dynamic_cast<symbol*>(top_emulation());
-                        auto* dest_r = dynamic_cast<reference_element*>(top_emulation());
-                        if (!dest_s && !dest_r)
+                        emulated_element* dest = top_emulation();
+                        if (!dest || (dest->kind != element_kinds::SYMBOL && dest->kind != element_kinds::REFERENCE))
                         {
                             asc::err("destination for allocation must be a symbol or array element reference");
                             return STATE_SYNTAX_ERROR;
                         }
-                        auto* type = dest_s ? dest_s->fqt.base : dest_r->fqt.base;
-                        int pointer = dest_s ? dest_s->fqt.pointer_level : dest_r->fqt.pointer_level;
-                        int offset = dest_s ? dest_s->offset : dest_r->offset;
+                        bool dest_s = dest->kind == element_kinds::SYMBOL;
+                        auto* type = dest_s ? dest->sym->fqt.base : dest->base;
+                        int pointer = dest_s ? dest->sym->fqt.pointer_level : dest->pointer_level;
+                        int offset = dest_s ? dest->sym->offset : dest->offset;
                         if (type->get_size() != 1 || pointer != 1)
                             as.instruct(scope->name(), "imul r8, " + std::to_string(pointer > 1 ? 8 : type->get_size()));
                         as.external("HeapAlloc");
@@ -1068,68 +1077,60 @@ namespace asc
                             offset) : "[rbx]") + ", rax");
                         preserve_value(get_register("rax"));
                         (it = output.erase(it))--;
+                        break;
                     }
-                }
-                // subscript operator
-                if (oper.value == "[")
-                {
-                    if (oper.operands == 2)
+                    case operators::SUBSCRIPT: // subscript operator
                     {
                         auto& index = retrieve_stack_value(get_register("rbx"));
-                        symbol* isym = dynamic_cast<symbol*>(top_emulation());
-                        reference_element* ire = dynamic_cast<reference_element*>(top_emulation());
-                        auto ire_pointer = ire ? ire->fqt.pointer_level : -1;
-                        auto* ire_type = ire ? ire->fqt.base : nullptr;
-                        auto* ire_specifiers = ire ? &(ire->fqt.specifiers) : nullptr;
+                        emulated_element* indexed = top_emulation();
+                        if (!indexed || (indexed->kind != element_kinds::SYMBOL && indexed->kind != element_kinds::REFERENCE))
+                        {
+                            asc::err("expected a symbol or array element reference on left hand side of subscript operator");
+                            return STATE_SYNTAX_ERROR;
+                        }
+                        bool isym = indexed->kind == element_kinds::SYMBOL;
+                        type_symbol* item_type = isym ? indexed->sym->fqt.base : indexed->base;
+                        int item_pointer = isym ? indexed->sym->fqt.pointer_level : indexed->pointer_level;
                         auto& item = retrieve_stack_value(get_register("rax"));
                         as.instruct(scope->name(), "lea rax, qword [rbx * " +
-                            std::to_string(isym ? (isym->fqt.pointer_level <= 1 ? isym->fqt.base->get_size() : 8) :
-                            (ire_pointer <= 1 ? ire_type->get_size() : 8)) + " + rax]");
-                        fully_qualified_type fqt = {
-                            isym ? isym->fqt.base : ire_type,
-                            isym ? isym->fqt.pointer_level : ire_pointer,
-                            isym ? isym->fqt.specifiers : *ire_specifiers
-                        };
-                        preserve_reference(get_register("rax"), fqt);
+                            std::to_string(item_pointer <= 1 ? item_type->get_size() : 8) + " + rax]");
+                        preserve_reference(get_register("rax"), item_type, item_pointer);
                         (it = output.erase(it))--;
+                        break;
                     }
-                }
-                // dot operator
-                if (oper.value == ".")
-                {
-                    if (oper.operands == 2)
+                    case operators::MEMBER: // dot operator
                     {
-                        symbol* member = dynamic_cast<symbol*>(top_emulation());
-                        if (member == nullptr)
+                        emulated_element* member_element = top_emulation();
+                        if (!member_element || member_element->kind != element_kinds::SYMBOL)
                         {
                             asc::err("expected field or method of an object on right hand side of dot operator");
                             return STATE_SYNTAX_ERROR;
                         }
+                        symbol* member = member_element->sym;
                         pop_emulation();
-                        symbol* obj = dynamic_cast<symbol*>(top_emulation());
-                        if (obj == nullptr)
+                        emulated_element* obj = top_emulation();
+                        if (!obj || obj->kind != element_kinds::SYMBOL)
                         {
                             asc::err("expected a symbol on left hand side of dot operator");
                             return STATE_SYNTAX_ERROR;
                         }
-                        type_symbol* obj_type = obj->fqt.base;
+                        type_symbol* obj_type = obj->sym->fqt.base;
                         auto& loc = retrieve_stack(get_register("rax"));
                         as.instruct(scope->name(), "lea rax, " + relative_dereference("rax", obj_type->calc_field_offset(member)));
-                        preserve_reference(loc, member->fqt);
+                        preserve_reference(loc, member->fqt.base, member->fqt.pointer_level);
                         (it = output.erase(it))--;
+                        break;
                     }
-                }
-                // casting operator
-                if (oper.value == "=>")
-                {
-                    if (oper.operands == 2)
+                    case operators::CAST: // casting operator
                     {
-                        type_symbol* dest_type = dynamic_cast<type_symbol*>(top_emulation());
-                        if (dest_type == nullptr)
+                        emulated_element* dest_element = top_emulation();
+                        if (!dest_element || dest_element->kind != element_kinds::SYMBOL ||
+                            !symbol_variants::is_type_variant(dest_element->sym->variant))
                         {
                             asc::err("expected a type on right hand side of casting operator");
                             return STATE_SYNTAX_ERROR;
                         }
+                        type_symbol* dest_type = static_cast<type_symbol*>(dest_element->sym);
                         if (!dest_type->is_primitive())
                         {
                             asc::err("casting to object types is not allowed yet");
@@ -1138,22 +1139,25 @@ namespace asc
                         pop_emulation();
                         bool is_double = dest_type == get_type("lreal");
                         bool fp_dest = dest_type->variant == symbol_variants::FLOATING_POINT_PRIMITIVE;
-                        stackable_element* convertee = top_emulation();
-                        integral_literal* il = dynamic_cast<integral_literal*>(convertee);
-                        storage_register* reg = dynamic_cast<storage_register*>(convertee);
-                        reference_element* re_el = dynamic_cast<reference_element*>(convertee);
-                        symbol* sym = dynamic_cast<symbol*>(convertee);
+                        if (stack_emulation.empty())
+                        {
+                            asc::err("left hand side of cast is not a candidate for casting");
+                            return STATE_SYNTAX_ERROR;
+                        }
+                        emulated_element convertee = *top_emulation();
+                        symbol* sym = convertee.kind == element_kinds::SYMBOL ? convertee.sym : nullptr;
+                        bool re_el = convertee.kind == element_kinds::REFERENCE;
                         storage_register* temp_dest = nullptr;
 
-                        asc::debug("casting candidate: " + convertee->to_string() + ", to: " + dest_type->to_string());
+                        asc::debug("casting candidate: " + convertee.to_string() + ", to: " + dest_type->to_string());
 
-                        if (il || (sym && sym->fqt.base->variant == symbol_variants::INTEGRAL_PRIMITIVE) ||
-                            (reg && !reg->is_fp_register()) || (re_el && !re_el->fp))
+                        if (convertee.kind == element_kinds::LITERAL ||
+                            (sym && sym->fqt.base != nullptr && sym->fqt.base->variant == symbol_variants::INTEGRAL_PRIMITIVE) ||
+                            ((convertee.kind == element_kinds::REGISTER || re_el) && !convertee.fp))
                         {
                             // retrieve value with sign extension if necessary
                             temp_dest = &(retrieve_stack_value(get_register("rax").byte_equivalent(fp_dest ? // integral -> integral
-                                8 : dest_type->get_size()), false, dest_type->get_size() > (il ?
-                                il->get_size() : (reg ? reg->get_size() : (re_el ? re_el->get_size() : sym->get_size()))), true));
+                                8 : dest_type->get_size()), false, dest_type->get_size() > convertee.get_size(), true));
                             if (fp_dest) // integral -> float/double
                             {
                                 // being converted to floating point
@@ -1162,8 +1166,7 @@ namespace asc
                                     + " xmm4, rax");
                             }
                         }
-                        else if ((sym && sym->fqt.base->variant == symbol_variants::FLOATING_POINT_PRIMITIVE) ||
-                            (reg && reg->is_fp_register()) || (re_el && re_el->fp))
+                        else if (convertee.kind != element_kinds::LITERAL && convertee.fp)
                         {
                             if (fp_dest) // float/double -> double/float
                             {
@@ -1179,8 +1182,8 @@ namespace asc
                                 }
                                 else if (re_el)
                                 {
-                                    as.instruct(scope->name(), "mov rax, " + relative_dereference("rbp", re_el->offset));
-                                    size = re_el->get_size();
+                                    as.instruct(scope->name(), "mov rax, " + relative_dereference("rbp", convertee.offset));
+                                    size = convertee.get_size();
                                     forg = true;
                                 }
                                 else
@@ -1188,14 +1191,14 @@ namespace asc
                                 if ((size == 8 && is_double) || (size != 8 && !is_double))
                                 {
                                     as.instruct(scope->name(), std::string("movs") + (size == 8 ? 'd' : 's') +
-                                        ' ' + temp_dest->m_name + ", " + (re_el != nullptr ? re_el->word() + " [rax]" : (sym != nullptr ? 
+                                        ' ' + temp_dest->m_name + ", " + (re_el ? convertee.word() + " [rax]" : (sym != nullptr ? 
                                         (sym->name_identified ? sym->word() + " [rax]" : sym->location()) : loc->m_name)));
                                 }
                                 else
                                 {
                                     as.instruct(scope->name(), std::string("cvts") + (size == 8 ? 'd' : 's') +
                                         "2s" + (is_double ? 'd' : 's') + ' ' + temp_dest->m_name + ", " +
-                                        (re_el != nullptr ? re_el->word() + " [rax]" : (sym != nullptr ? (sym->name_identified ?
+                                        (re_el ? convertee.word() + " [rax]" : (sym != nullptr ? (sym->name_identified ?
                                         sym->word() + " [rax]" : sym->location()) : loc->m_name)));
                                 }
                                 if (forg) forget_top();
@@ -1217,14 +1220,12 @@ namespace asc
                         }
                         preserve_value(*temp_dest, dest_type->get_size());
                         (it = output.erase(it))--;
+                        break;
                     }
-                }
-                // scope operator
-                if (oper.value == "::")
-                {
-                    if (oper.operands == 2)
+                    case operators::SCOPE: // scope operator
                     {
-                        symbol* scoped = dynamic_cast<symbol*>(top_emulation());
+                        emulated_element* scoped_element = top_emulation();
+                        symbol* scoped = scoped_element && scoped_element->kind == element_kinds::SYMBOL ? scoped_element->sym : nullptr;
                         if (!scoped)
                         {
                             asc::err("expected a symbol on right hand side of scope operator");
@@ -1235,24 +1236,25 @@ namespace asc
                         //else
                         //    retrieve_stack()
 
+                        break;
                     }
                 }
             }
             else if (sym != nullptr && (sym->variant == symbol_variants::FUNCTION ||
                 sym->variant == symbol_variants::METHOD || sym->variant == symbol_variants::CONSTRUCTOR_METHOD)) // function call
             {
-                auto* f_sym = dynamic_cast<function_symbol*>(sym);
+                auto* f_sym = static_cast<function_symbol*>(sym);
                 asc::debug("calling: " + f_sym->to_string());
                 bool is_method = sym->variant == symbol_variants::METHOD;
-                if (is_method && (it + 1) < output.end() && (it + 1)->value == ".")
+                if (is_method && (it + 1) < output.end() && (it + 1)->oper == operators::MEMBER)
                 {
-                    auto* obj = dynamic_cast<symbol*>(emulation_element(f_sym->parameters.size()));
-                    if (obj == nullptr)
+                    emulated_element* obj = emulation_element(f_sym->parameters.size());
+                    if (!obj || obj->kind != element_kinds::SYMBOL)
                     {
                         asc::err("attempting to call method on non-object");
                         return STATE_SYNTAX_ERROR;
                     }
-                    as.instruct(scope->name(), "mov rcx, " + relative_dereference("rbp", obj->offset));
+                    as.instruct(scope->name(), "mov rcx, " + relative_dereference("rbp", obj->sym->offset));
                     (it = output.erase(it + 1))--; // remove dot operator
                 }
                 for (int i = is_method ? 1 : 0; i < (f_sym->parameters.size() > 4 ? 4 : f_sym->parameters.size()); i++)
@@ -1274,7 +1276,7 @@ namespace asc
                     h += top_size;
                 }
                 // delete object a method is being called on (if necessary)
-                if (is_method && (it + 1) < output.end() && (it + 1)->value == ".") forget_top();
+                if (is_method && (it + 1) < output.end() && (it + 1)->oper == operators::MEMBER) forget_top();
                 as.instruct(scope->name(), "call " + f_sym->m_name);
                 if (f_sym->get_size() != 0)
                     preserve_value(get_register(f_sym->fqt.base->variant == symbol_variants::FLOATING_POINT_PRIMITIVE ? "xmm0" : "rax").byte_equivalent(f_sym->get_size()), f_sym->get_size()); // preserve the return value
@@ -1283,14 +1285,15 @@ namespace asc
             else if (sym != nullptr && sym->variant == symbol_variants::CONSTRUCTOR_METHOD &&
                 sym->scope->variant == symbol_variants::STRUCTLIKE_TYPE)
             {
-                auto* f_sym = dynamic_cast<function_symbol*>(sym);
+                auto* f_sym = static_cast<function_symbol*>(sym);
                 asc::debug("calling implicit type constructor: " + f_sym->to_string());
-                auto* t_sym = dynamic_cast<type_symbol*>(symbol_table_get(f_sym->m_name.substr(2)));
-                if (!t_sym)
+                symbol* type = symbol_table_get(f_sym->m_name.substr(2));
+                if (!type || !symbol_variants::is_type_variant(type->variant))
                 {
                     asc::err("could not find type associated with implicit constructor (somehow..)");
                     return STATE_SYNTAX_ERROR;
                 }
+                auto* t_sym = static_cast<type_symbol*>(type);
                 init_heap();
                 as.instruct(scope->name(), "mov rcx, qword [" + std::string(HEAP_PTR_IDENTIFIER) + ']');
                 as.instruct(scope->name(), "mov rdx, 8");
@@ -1301,7 +1304,8 @@ namespace asc
                 for (auto* member : t_sym->fields)
                 {
                     auto& meml = retrieve_stack_value(get_register(member->is_floating_point() ? "xmm4" : "rbx"));
-                    as.instruct(scope->name(), "mov" + meml.instruction_suffix() + ' ' + relative_dereference("rax", type_offset, meml.word())
+                    as.instruct(scope->name(), "mov" + meml.instruction_suffix() + ' ' + relative_dereference("rax", type_offset,
+                        meml.is_fp_register() ? member->word() : meml.word())
                         + ", " + meml.m_name);
                     type_offset += member->get_size();
                 }
@@ -1310,8 +1314,8 @@ namespace asc
             }
             else if (sym != nullptr) // symbol
             {
-                if (sym->variant == symbol_variants::NAMESPACE || dynamic_cast<type_symbol*>(sym) != nullptr) // if it's a type symbol
-                    push_emulation(sym);
+                if (sym->variant == symbol_variants::NAMESPACE || symbol_variants::is_type_variant(sym->variant)) // if it's a type symbol
+                    push_emulation(symbol_element(sym));
                 else
                     preserve_symbol(sym);
                 (it = output.erase(it))--;
@@ -1319,7 +1323,7 @@ namespace asc
             else if (is_string_literal(*token)) // string literal
             {
                 symbol* str = symbol_table_insert("_SL" + std::to_string(slc),
-                    new symbol("_SL" + std::to_string(slc), { get_type("char"), 1 }, symbol_variants::GLOBAL_VARIABLE, visibilities::PRIVATE, nullptr, nullptr));
+                    make_symbol<symbol>("_SL" + std::to_string(slc), fully_qualified_type{ get_type("char"), 1 }, symbol_variants::GLOBAL_VARIABLE, visibilities::PRIVATE, nullptr, nullptr));
                 str->name_identified = true;
                 as << asc::data << str->m_name + " db " + *token + ", 0x00";
                 slc++;
@@ -1329,16 +1333,14 @@ namespace asc
             else if (is_number_literal(*token, true)) // integral constants
             {
                 as.instruct(scope->name(), "mov dword " + asc::relative_dereference("rbp", reserve_data_space(4)) + ", " + *token); // temporary
-                integral_literal* il = new integral_literal(4);
-                il->dynamic = true; 
-                push_emulation(il);
+                push_emulation(literal_element(4));
                 (it = output.erase(it))--;
             }
             else if (is_number_literal(*token)) // floating point constants
             {
                 bool is_double = is_double_literal(*token);
                 symbol* fpl = symbol_table_insert("_FPL" + std::to_string(fplc),
-                    new symbol("_FPL" + std::to_string(fplc), { get_type(is_double ? "lreal" : "real") },
+                    make_symbol<symbol>("_FPL" + std::to_string(fplc), fully_qualified_type{ get_type(is_double ? "lreal" : "real") },
                     symbol_variants::GLOBAL_VARIABLE, visibilities::PRIVATE, nullptr, nullptr));
                 fpl->name_identified = true;
                 as << asc::data << fpl->m_name + " d" + (is_double ? "q " : "d ") + strip_number_literal(*token);
@@ -1350,30 +1352,31 @@ namespace asc
             }
             else
             {
-                auto lit = stack_emulation.end() - 1;
-                for (; lit >= stack_emulation.begin(); lit--)
+                size_t lit = stack_emulation.size();
+                for (; lit > 0; lit--)
                 {
-                    auto* t = dynamic_cast<symbol*>(*lit);
-                    if (!t) continue;
+                    if (stack_emulation[lit - 1].kind != element_kinds::SYMBOL) continue;
+                    symbol* t = stack_emulation[lit - 1].sym;
                     if (!(t->fqt.base)) continue;
+                    lexeme_id id = element->value;
                     auto it_mem = std::find_if(t->fqt.base->fields.begin(), t->fqt.base->fields.end(),
-                        [token](symbol* member) -> bool { return member->m_name == *token; });
+                        [id](symbol* member) -> bool { return member->id == id; });
                     if (it_mem != t->fqt.base->fields.end())
                     {
-                        push_emulation(*it_mem);
+                        push_emulation(symbol_element(*it_mem));
                         (it = output.erase(it))--;
                         break;
                     }
                     auto it_method = std::find_if(t->fqt.base->methods.begin(), t->fqt.base->methods.end(),
-                        [token](symbol* method) -> bool { return method->m_name == *token; });
+                        [id](symbol* method) -> bool { return method->id == id; });
                     if (it_method != t->fqt.base->methods.end())
                     {
-                        push_emulation(*it_method);
+                        push_emulation(symbol_element(*it_method));
                         (it = output.erase(it))--;
                         break;
                     }
                 }
-                if (lit < stack_emulation.begin())
+                if (lit == 0)
                 {
                     asc::err("invalid token encountered while parsing expression");
                     return STATE_SYNTAX_ERROR;
@@ -1384,29 +1387,19 @@ namespace asc
         return STATE_FOUND;
     }
 
-    evaluation_state parser::eval_expression()
-    {
-        syntax_node* current = this->current;
-        return eval_expression(current);
-    }
-
-    evaluation_state parser::eval_return_statement(syntax_node*& lcurrent)
+    evaluation_state parser::eval_return_statement(expression_statement* node)
     {
-        if (check_eof(lcurrent, true))
-            return STATE_NEUTRAL;
-        if (*lcurrent != "return")
-            return STATE_NEUTRAL;
         if (scope == nullptr)
         {
-            asc::err("return statement outside of function", lcurrent->line);
+            asc::err("return statement outside of function", node->line);
             return STATE_SYNTAX_ERROR;
         }
         if (scope->variant == symbol_variants::CONSTRUCTOR_METHOD)
         {
-            asc::err("return statement not allowed in constructors", lcurrent->line);
+            asc::err("return statement not allowed in constructors", node->line);
             return STATE_SYNTAX_ERROR;
         }
-        auto exp = eval_expression(lcurrent = lcurrent->next);
+        auto exp = eval_expression(node->expression);
         if (exp != STATE_FOUND)
             return exp;
         retrieve_stack_value(get_register(get_current_function()->fqt.base->variant !=
@@ -1414,24 +1407,14 @@ namespace asc
         return STATE_FOUND;
     }
 
-    evaluation_state parser::eval_return_statement()
-    {
-        syntax_node* current = this->current;
-        return eval_return_statement(current);
-    }
-
-    evaluation_state parser::eval_delete_statement(syntax_node*& lcurrent)
+    evaluation_state parser::eval_delete_statement(expression_statement* node)
     {
-        if (check_eof(lcurrent, true))
-            return STATE_NEUTRAL;
-        if (*lcurrent != "delete")
-            return STATE_NEUTRAL;
         if (scope == nullptr)
         {
-            asc::err("delete statement outside of function", lcurrent->line);
+            asc::err("delete statement outside of function", node->line);
             return STATE_SYNTAX_ERROR;
         }
-        auto exp = eval_expression(lcurrent = lcurrent->next);
+        auto exp = eval_expression(node->expression);
         if (exp != STATE_FOUND)
             return exp;
         init_heap();
@@ -1443,417 +1426,62 @@ namespace asc
         return STATE_FOUND;
     }
 
-    evaluation_state parser::eval_delete_statement()
-    {
-        syntax_node* current = this->current;
-        return eval_delete_statement(current);
-    }
-
-    evaluation_state parser::eval_type_construct(syntax_node*& lcurrent)
-    {
-        if (check_eof(lcurrent, true))
-            return STATE_NEUTRAL;
-        syntax_node* slcurrent = lcurrent;
-        evaluation_state v_state = visibilities::value_of(asc::to_uppercase(*(slcurrent->value))) != visibilities::INVALID;
-        std::string v = "private"; // default to private
-        if (v_state == STATE_FOUND) // if a specifier was found, add it
-            v = *(slcurrent->value);
-        if (v_state == STATE_SYNTAX_ERROR)
-            return STATE_SYNTAX_ERROR;
-        if (check_eof(slcurrent = slcurrent->next))
-            return STATE_NEUTRAL;
-        if (*(slcurrent) != "type") // not a type
-            return STATE_NEUTRAL;
-        lcurrent = slcurrent; // sync up local current with super local current
-        if (check_eof(lcurrent = lcurrent->next)) // move forward to identifier
-            return STATE_SYNTAX_ERROR;
-        std::string identifier = *(lcurrent->value); // get the identifier
-        if (check_eof(lcurrent = lcurrent->next)) // move forward
-            return STATE_SYNTAX_ERROR;
-        if ((*lcurrent) == "extends")
-        {
-            asc::err("inheritance is not implemented yet", lcurrent->line);
-            return STATE_SYNTAX_ERROR;
-        }
-        if ((*lcurrent) != "{") // if we're not starting the type
-        {
-            asc::err("type definition expected", lcurrent->line);
-            return STATE_SYNTAX_ERROR;
-        }
-        if (check_eof(lcurrent = lcurrent->next)) // move past brace
-            return STATE_SYNTAX_ERROR;
-        type_symbol* sym = new type_symbol(identifier, {}, symbol_variants::STRUCTLIKE_TYPE,
-            visibilities::value_of(asc::to_uppercase(v)), 0, ns, this->scope);
-        symbol_table_insert(identifier, sym);
-        int overall_size = 0; // keep track of type's size
-        while (!check_eof(lcurrent) && *(lcurrent) != "}")
-        {
-            int t_line = lcurrent->line;
-            fully_qualified_type fqt;
-            evaluation_state t_state = eval_full_type(lcurrent, fqt);
-            if (t_state == STATE_SYNTAX_ERROR)
-                return STATE_SYNTAX_ERROR;
-            if (t_state == STATE_NEUTRAL)
-            {
-                asc::err("type expected", t_line);
-                return STATE_SYNTAX_ERROR;
-            }
-            std::string identifier = *(lcurrent->value);
-            if (lcurrent->type != syntax_types::IDENTIFIER)
-            {
-                asc::err("identifier expected", lcurrent->line);
-                return STATE_SYNTAX_ERROR;
-            }
-            syntax_node* identifier_node = lcurrent;
-            symbol* member_symbol = new symbol(identifier, fqt, symbol_variants::STRUCTLIKE_TYPE_MEMBER,
-                visibilities::PUBLIC, ns, static_cast<symbol*>(sym));
-            sym->fields.push_back(member_symbol);
-            //symbol_table_insert(identifier, member_symbol);
-            overall_size += fqt.base->get_size();
-            while (!check_eof(lcurrent = lcurrent->next) && *(lcurrent) != ";");
-            if (lcurrent == nullptr)
-                return STATE_SYNTAX_ERROR;
-            if (check_eof(lcurrent = lcurrent->next)) // skip semicolon
-                return STATE_SYNTAX_ERROR;
-        }
-        sym->size = overall_size; // update type's size with the size of its members
-        current = lcurrent = lcurrent->next;
-        asc::debug("created type: " + sym->to_string());
-        return STATE_FOUND;
-    }
-
-    evaluation_state parser::eval_type_construct()
+    // Types are laid out when they are declared, none of them is lowered
+    evaluation_state parser::eval_type_construct(type_node* node)
     {
-        syntax_node* current = this->current;
-        return eval_type_construct(current);
+        return declarations.count(node) != 0 ? STATE_FOUND : declare_type(node);
     }
 
-    evaluation_state parser::eval_object_construct(syntax_node*& lcurrent)
+    evaluation_state parser::eval_object_construct(block_node* node)
     {
-        if (check_eof(lcurrent, true))
-            return STATE_NEUTRAL;
-        syntax_node* slcurrent = lcurrent;
-        evaluation_state v_state = visibilities::value_of(asc::to_uppercase(*(slcurrent->value))) != visibilities::INVALID;
-        std::string v = "private"; // default to private
-        if (v_state == STATE_FOUND) // if a specifier was found, add it
-            v = *(slcurrent->value);
-        if (v_state == STATE_SYNTAX_ERROR)
-            return STATE_SYNTAX_ERROR;
-        if (check_eof(slcurrent = slcurrent->next))
-            return STATE_NEUTRAL;
-        if (*(slcurrent) != "object") // not an object
-            return STATE_NEUTRAL;
-        lcurrent = slcurrent; // sync up local current with super local current
-        if (check_eof(lcurrent = lcurrent->next)) // move forward to identifier
-            return STATE_SYNTAX_ERROR;
-        std::string identifier = *(lcurrent->value); // get the identifier
-        if (check_eof(lcurrent = lcurrent->next)) // move forward
-            return STATE_SYNTAX_ERROR;
-        if ((*lcurrent) == "extends")
-        {
-            asc::err("inheritance is not implemented yet", lcurrent->line);
+        if (declarations.count(node) == 0 && declare_object(node) != STATE_FOUND) // declared inside a function
             return STATE_SYNTAX_ERROR;
-        }
-        if ((*lcurrent) != "{") // if we're not starting the object
-        {
-            asc::err("object definition expected", lcurrent->line);
-            return STATE_SYNTAX_ERROR;
-        }
-        if (check_eof(lcurrent = lcurrent->next)) // move past brace
-            return STATE_SYNTAX_ERROR;
-        auto* start = lcurrent;
-        type_symbol* sym = new type_symbol(identifier, {}, symbol_variants::OBJECT,
-            visibilities::value_of(asc::to_uppercase(v)), 8, ns, this->scope);
-        symbol_table_insert(identifier, sym);
-        // go through, define methods and find the size of the type
-        while (!check_eof(lcurrent, true) && *lcurrent != "}")
-        {
-            auto of = eval_object_field(lcurrent, sym);
-            if (of == STATE_SYNTAX_ERROR)
-                return STATE_SYNTAX_ERROR;
-            if (of == STATE_FOUND)
-                continue;
-            auto om = eval_object_method(lcurrent, sym);
-            if (om == STATE_SYNTAX_ERROR)
-                return STATE_SYNTAX_ERROR;
-            if (om == STATE_FOUND)
-                continue;
-        }
-        lcurrent = start; // move back to the beginning of the object
-        current = lcurrent;
+        type_symbol* sym = static_cast<type_symbol*>(declarations[node]);
+        for (symbol* field : sym->fields)
+            symbol_table_insert(field->id, field);
+        for (function_symbol* method : sym->methods)
+            symbol_table_insert(method->id, method);
         scope = sym; // scope into object
-        return STATE_FOUND;
-    }
-
-    evaluation_state parser::eval_object_construct()
-    {
-        syntax_node* current = this->current;
-        return eval_object_construct(current);
-    }
-
-    evaluation_state parser::eval_object_field(syntax_node*& lcurrent, type_symbol* obj)
-    {
-        syntax_node* slcurrent = lcurrent;
-        if (check_eof(slcurrent, true))
-            return STATE_NEUTRAL;
-        visibility v = scope != nullptr ? visibilities::LOCAL : visibilities::value_of(to_uppercase(*(slcurrent->value)));
-        if (v != visibilities::INVALID && v != visibilities::LOCAL)
-            slcurrent = slcurrent->next;
-        if (v == visibilities::INVALID)
-            v = visibilities::PRIVATE;
-        if (check_eof(slcurrent, true))
-            return STATE_NEUTRAL;
-        fully_qualified_type fqt;
-        auto t_state = eval_full_type(slcurrent, fqt);
-        if (t_state == STATE_NEUTRAL || t_state == STATE_SYNTAX_ERROR)
-            return t_state;
-        if (check_eof(slcurrent, true))
-            return STATE_NEUTRAL;
-        syntax_node* i_node = slcurrent; // copy identifier syntax node
-        std::string i = *(slcurrent->value);
-        if (symbol_table_get_imm(i) != nullptr) // symbol with this name already exists in this scope
-        {
-            asc::err("symbol is already defined", slcurrent->line);
-            return STATE_SYNTAX_ERROR;
-        }
-        if (check_eof(slcurrent = slcurrent->next, true))
-            return STATE_NEUTRAL;
-        bool arrayalloc = *(slcurrent->value) == "~=";
-        if (*(slcurrent->value) != "=" && *(slcurrent->value) != ";" && *(slcurrent->value) != "~=") // this is NOT a variable declaration (most likely a function declaration)
-            return STATE_NEUTRAL;
-        symbol* member_symbol = symbol_table_insert(i, new symbol(i, fqt, symbol_variants::STRUCTLIKE_TYPE_MEMBER,
-                visibilities::PUBLIC, ns, static_cast<symbol*>(obj)));
-        obj->fields.push_back(member_symbol);
-        obj->size += fqt.base->get_size();
-        lcurrent = slcurrent;
-        for (; !check_eof(lcurrent, true) && *(lcurrent->value) != ";"; lcurrent = lcurrent->next);
-        if (check_eof(lcurrent))
-            return STATE_SYNTAX_ERROR;
-        lcurrent = lcurrent->next; // pass semicolon
-        return STATE_FOUND;
-    }
-
-    evaluation_state parser::eval_object_method(syntax_node*& lcurrent, type_symbol* obj)
-    {
-        if (check_eof(lcurrent, true))
-            return STATE_NEUTRAL;
-        syntax_node* slcurrent = lcurrent;
-        // errors will be thrown later on once we CONFIRM this is supposed to be a function declaration
-        evaluation_state v_state = visibilities::value_of(asc::to_uppercase(*(slcurrent->value))) != visibilities::INVALID;
-        std::string v = "private"; // default to private
-        if (v_state == STATE_FOUND) // if a specifier was found, add it
-            v = *(slcurrent->value);
-        if (v_state == STATE_SYNTAX_ERROR)
-            return STATE_SYNTAX_ERROR;
-        //asc::debug('v' << std::endl;
-        if (v_state != STATE_NEUTRAL)
-        {
-            slcurrent = slcurrent->next;
-            if (check_eof(slcurrent, true))
-                return STATE_NEUTRAL;
-        }
-        int t_line = -1;
-        fully_qualified_type fqt;
-        evaluation_state t_state = STATE_FOUND;
-        if (*slcurrent != "constructor")
-        {
-            t_line = slcurrent->line;
-            t_state = eval_full_type(slcurrent, fqt);
-            if (t_state == STATE_NEUTRAL || t_state == STATE_SYNTAX_ERROR)
-                return t_state;
-            //asc::debug('t' << std::endl;
-            // at this point, it could still be a variable definition/declaration, so let's continue
-            if (check_eof(slcurrent, true))
-                return STATE_NEUTRAL;
-        }
-        else
-            fqt = { obj, 1 };
-        int i_line = slcurrent->line;
-        std::string& identifier = *(slcurrent->value); // get the identifier that MIGHT be there
-        bool is_constructor = identifier == "constructor";
-        if (is_constructor) // constructor method
-            identifier = "_C" + obj->m_name;
-        //asc::debug('i' << std::endl;
-        slcurrent = slcurrent->next;
-        if (check_eof(slcurrent, true))
-            return STATE_NEUTRAL;
-        if (*(slcurrent->value) != "(") // if there is no parenthesis, it's confirmed that this is not a variable declaration
-            return STATE_NEUTRAL; // return a neutral state, indicating no change
-        lcurrent = slcurrent;
-        // now let's throw some errors
-        if (t_state == STATE_NEUTRAL) // if there was no type specifier, throw an error
-        {
-            asc::err("type specifier expected", t_line);
-            return STATE_SYNTAX_ERROR;
-        }
-        if (symbol_table_get_imm(identifier) != nullptr)
-        {
-            asc::err("symbol is already defined");
-            return STATE_SYNTAX_ERROR;
-        }
-        symbol* sobj = dynamic_cast<symbol*>(obj);
-        function_symbol* f_symbol = dynamic_cast<function_symbol*>(symbol_table_insert(identifier, new asc::function_symbol(identifier, fqt,
-            is_constructor ? symbol_variants::CONSTRUCTOR_METHOD : symbol_variants::METHOD, visibilities::value_of(asc::to_uppercase(v)), ns, sobj, false)));
-        obj->methods.push_back(f_symbol);
-        if (!is_constructor) // add this parameter for non-constructor methods
-        {
-            symbol* that = new asc::symbol("this", { obj, 1 },
-                symbol_variants::PARAMETER_VARIABLE, visibilities::INVALID, ns, f_symbol);
-            f_symbol->parameters.push_back(that);
-            that->offset = 16;
-        }
-        for (int c = is_constructor ? 1 : 2, s = is_constructor ? 8 : 16; true; c++) // loop until we're at the end of the declaration, this is an infinite loop to make code smoother
-        {
-            lcurrent = lcurrent->next; // first, the argument type
-            if (check_eof(lcurrent))
-                return STATE_SYNTAX_ERROR;
-            if (*(lcurrent->value) == ")") // if there are no more arguments, leave the loop
-                break;
-            int at_line = lcurrent->line;
-            fully_qualified_type afqt;
-            evaluation_state at_state = eval_full_type(lcurrent, afqt);
-            if (at_state == STATE_SYNTAX_ERROR)
-                return STATE_SYNTAX_ERROR;
-            if (at_state == STATE_NEUTRAL) // if there was no type specifier, throw an error
-            {
-                asc::err("type specifier expected for argument " + std::to_string(c), at_line);
-                return STATE_SYNTAX_ERROR;
-            }
-            // second, the argument identifier
-            if (check_eof(lcurrent))
-                return STATE_SYNTAX_ERROR;
-            if (*lcurrent == "," || *lcurrent == ")") // nameless argument
-            {
-                asc::err("nameless function arguments are not allowed", at_line);
-                return STATE_SYNTAX_ERROR;
-            }
-            int ai_line = lcurrent->line;
-            std::string& a_identifier = *(lcurrent->value); // get the identifier that MIGHT be there
-            if (symbol_table_get_imm(a_identifier, f_symbol) != nullptr) // if symbol already exists in this scope
-            {
-                asc::err("symbol is already defined", ai_line);
-                return STATE_SYNTAX_ERROR;
-            }
-            symbol* a_symbol = new asc::symbol(a_identifier, afqt,
-                symbol_variants::PARAMETER_VARIABLE, visibilities::PUBLIC, ns, static_cast<symbol*>(f_symbol));
-            f_symbol->parameters.push_back(a_symbol);
-            a_symbol->offset = s += 8;
-            lcurrent = lcurrent->next; // lastly, what's next?
-            if (check_eof(lcurrent))
-                return STATE_SYNTAX_ERROR;
-            if (*(lcurrent->value) == ")") // if there are no more arguments, leave the loop
-                break;
-            if (*(lcurrent->value) != ",") // if there are more args and the next is not a comma
-            {
-                asc::err("unexpected end to argument listing", lcurrent->line);
-                return STATE_SYNTAX_ERROR;
-            }
-        }
-        // after argument listing, scope into function if syntax is correct
-        lcurrent = lcurrent->next;
-        if (check_eof(lcurrent))
+        symbols.enter_scope(scope);
+        if (eval_statements(node->body) != STATE_FOUND)
             return STATE_SYNTAX_ERROR;
-        if (*(lcurrent->value) != "{") // if the syntax is not right
-        {
-            asc::err("expected a left curly brace to start function", lcurrent->line);
-            return STATE_SYNTAX_ERROR;
-        }
-        lcurrent = lcurrent->next; // move into the function
-        for (int b_level = 1; b_level > 0; lcurrent = lcurrent->next) // move past entire function
-        {
-            if (check_eof(lcurrent))
-                return STATE_SYNTAX_ERROR;
-            if (*lcurrent == "{")
-                b_level++;
-            if (*lcurrent == "}")
-                b_level--;
-        }
-        current = lcurrent; // move member current to its proper location
-        asc::debug("defined method in " + obj->m_name + ": " + f_symbol->to_string());
-        return STATE_FOUND; // finally, return the proper state
+        return eval_block_ending();
     }
 
-    evaluation_state parser::eval_namespace(syntax_node*& lcurrent)
+    evaluation_state parser::eval_namespace(block_node* node)
     {
-        if (check_eof(lcurrent, true))
-            return STATE_NEUTRAL;
-        if (*lcurrent != "namespace") // not a namespace
-            return STATE_NEUTRAL;
-        if (check_eof(lcurrent = lcurrent->next))
+        if (declarations.count(node) == 0 && declare_namespace(node) != STATE_FOUND)
             return STATE_SYNTAX_ERROR;
-        symbol* nns = symbol_table_insert(*(lcurrent->value), new symbol(*(lcurrent->value), {},
-            symbol_variants::NAMESPACE, visibilities::INVALID, ns, scope));
-        if (check_eof(lcurrent = lcurrent->next)) // skip to left entry brace
-            return STATE_SYNTAX_ERROR;
-        if (check_eof(lcurrent = lcurrent->next)) // enter namespace
+        ns = declarations[node]; // scope into namespace
+        if (eval_statements(node->body) != STATE_FOUND)
             return STATE_SYNTAX_ERROR;
-        ns = nns; // scope into namespace
+        asc::debug("leaving namespace " + ns->to_string());
+        ns = ns->ns;
         return STATE_FOUND;
     }
 
-    evaluation_state parser::eval_namespace()
-    {
-        syntax_node* current = this->current;
-        return eval_namespace(current);
-    }
-
-    evaluation_state parser::eval_full_type(syntax_node*& lcurrent, fully_qualified_type& fqt)
+    // Resolves a type written in the source to the symbols it names
+    evaluation_state parser::eval_full_type(const type_expression& type, fully_qualified_type& fqt)
     {
-        syntax_node* slcurrent = lcurrent;
-        if (check_eof(slcurrent, true))
-            return STATE_NEUTRAL;
-        unsigned char signedness = 0;   // 0 - signed, unspecified
-                                        // 1 - signed, specified
-                                        // 2 - unsigned
-        char length = '\0';
-        while (!check_eof(slcurrent, true))
-        {
-            specifier s = specifiers::value_of(*(slcurrent->value));
-            if (*slcurrent == "signed")
-                signedness = 1;
-            else if (*slcurrent == "unsigned")
-                signedness = 2;
-            else if (*slcurrent == "short")
-                length = 's';
-            else if (*slcurrent == "long")
-                length = 'l';
-            else if (s != specifiers::INVALID)
-                fqt.specifiers.insert(s);
-            else
-                break;
-            slcurrent = slcurrent->next;
-        }
-        std::string identifier = (signedness == 2 ? "u" : "") + (length ? std::string() + length : "") +
-            *(slcurrent->value);
-        asc::symbol* type = symbol_table_get(identifier);
-        if (type == nullptr)
-            return STATE_NEUTRAL;
-        if (type->variant != symbol_variants::OBJECT &&
-                type->variant != symbol_variants::STRUCTLIKE_TYPE &&
-                type->variant != symbol_variants::PRIMITIVE &&
-                type->variant != symbol_variants::INTEGRAL_PRIMITIVE &&
-                type->variant != symbol_variants::UNSIGNED_INTEGRAL_PRIMITIVE &&
-                type->variant != symbol_variants::FLOATING_POINT_PRIMITIVE)
-            return STATE_NEUTRAL;
-        if (signedness == 1 && type->variant != symbol_variants::INTEGRAL_PRIMITIVE)
-        {
-            asc::err("cannot apply modifier 'signed' to type '" + type->m_name + '\'', slcurrent->line);
+        asc::symbol* base = symbol_table_get(type.name);
+        if (base == nullptr || (base->variant != symbol_variants::OBJECT &&
+                base->variant != symbol_variants::STRUCTLIKE_TYPE &&
+                base->variant != symbol_variants::PRIMITIVE &&
+                base->variant != symbol_variants::INTEGRAL_PRIMITIVE &&
+                base->variant != symbol_variants::UNSIGNED_INTEGRAL_PRIMITIVE &&
+                base->variant != symbol_variants::FLOATING_POINT_PRIMITIVE))
+        {
+            asc::err("'" + lexeme(type.name) + "' does not name a type in this scope", type.line);
             return STATE_SYNTAX_ERROR;
         }
-        fqt.base = dynamic_cast<type_symbol*>(type);
-        slcurrent = slcurrent->next;
-        fqt.pointer_level = 0;
-        if (!check_eof(slcurrent, true) && *slcurrent == "[")
+        if (type.signed_specified && base->variant != symbol_variants::INTEGRAL_PRIMITIVE)
         {
-            asc::err("obsolete type, use pointers instead", slcurrent->line);
+            asc::err("cannot apply modifier 'signed' to type '" + base->m_name + '\'', type.line);
             return STATE_SYNTAX_ERROR;
         }
-        while (!check_eof(slcurrent, true) && *slcurrent == "*")
-        {
-            fqt.pointer_level++;
-            slcurrent = slcurrent->next;
-        }
-        lcurrent = slcurrent;
+        fqt.base = dynamic_cast<type_symbol*>(base);
+        fqt.pointer_level = type.pointer_level;
+        fqt.specifiers = type.specifiers;
         return STATE_FOUND;
     }
 
@@ -1861,17 +1489,12 @@ namespace asc
     {
         if (size == -1)
             size = location.get_size();
-        fp_register* fpr = dynamic_cast<fp_register*>(&location);
-        if (fpr != nullptr)
-        {
-            asc::debug("effective size added for register " + location.m_name + ": " + std::to_string(size));
-            fpr->effective_sizes.push(size);
-        }
+        bool fp = location.is_fp_register();
         int position = (dpc += size);
         if (dpc > dpm) dpm = dpc; // update max if needed
-        push_emulation(&location);
+        push_emulation(register_element(location, size)); // a floating point register is read back at the size it is preserved with
         as.instruct(scope != nullptr ? scope->name() : this->scope->name(), "mov" +
-            (fpr ? std::string("s") + (size == 4 ? 's' : 'd') : "") + ' ' + asc::relative_dereference("rbp", -position, asc::word(size)) + ", " + location.m_name);
+            (fp ? std::string("s") + (size == 4 ? 's' : 'd') : "") + ' ' + asc::relative_dereference("rbp", -position, asc::word(size)) + ", " + location.m_name);
         asc::debug("preserved " + location.to_string() + ", stack size now " + std::to_string(dpc));
         return -position;
     }
@@ -1887,7 +1510,7 @@ namespace asc
     {
         int position = (dpc += sym->get_size());
         if (dpc > dpm) dpm = dpc; // update max if needed
-        push_emulation(sym);
+        push_emulation(symbol_element(sym));
         storage_register& transfer_register = get_register("r12").byte_equivalent(sym->get_size());
         as.instruct(scope != nullptr ? scope->name() : this->scope->name(), "mov " + transfer_register.m_name + ", " + sym->location());
         as.instruct(scope != nullptr ? scope->name() : this->scope->name(), "mov " + asc::relative_dereference("rbp", -position, sym->word()) + ", " + transfer_register.m_name);
@@ -1899,17 +1522,16 @@ namespace asc
      * @brief Pushes a reference to the stack
      * 
      * @param location The location of a memory address
-     * @param fqt Fully qualified type of the reference
+     * @param base Type of the value referenced
+     * @param pointer_level Pointer level of the value referenced
      * @param scope Scope of the instructions
      * @return Position of the reference on the stack
      */
-    int parser::preserve_reference(storage_register& location, fully_qualified_type& fqt, symbol* scope)
+    int parser::preserve_reference(storage_register& location, type_symbol* base, int pointer_level, symbol* scope)
     {
         int position = (dpc += 8);
         if (dpc > dpm) dpm = dpc; // update max if needed
-        reference_element* re = new reference_element(-position, fqt.base->is_floating_point(), fqt);
-        re->dynamic = true;
-        push_emulation(re);
+        push_emulation(reference_element(-position, base, pointer_level));
         as.instruct(scope != nullptr ? scope->name() : this->scope->name(), "mov " +
             asc::relative_dereference("rbp", -position, location.word()) + ", " + location.m_name);
         asc::debug("preserved reference to mem addr in " + location.to_string() + ", stack size now " + std::to_string(dpc));
@@ -1936,19 +1558,17 @@ namespace asc
      */
     storage_register& parser::retrieve_stack(storage_register& storage, bool cc, bool sx, bool use_passed_storage, int* size)
     {
-        stackable_element* element = top_emulation();
-        symbol* sym = dynamic_cast<symbol*>(element);
-        reference_element* re = dynamic_cast<reference_element*>(element);
-        fp_register* fp_element = dynamic_cast<fp_register*>(element);
-        int lsize = re != nullptr ? 8 : !sx && !use_passed_storage && fp_element ? fp_element->effective_sizes.top() : element->get_size();
+        emulated_element element = *top_emulation();
+        symbol* sym = element.kind == element_kinds::SYMBOL ? element.sym : nullptr;
+        emulated_element* re = element.kind == element_kinds::REFERENCE ? &element : nullptr;
+        bool fp_element = element.kind == element_kinds::REGISTER && element.fp;
+        int lsize = re != nullptr ? 8 : !sx && !use_passed_storage && fp_element ? element.size : element.get_size();
         storage_register& dest = sx || use_passed_storage ? storage : storage.byte_equivalent(lsize);
-        std::string w = fp_element ? word(fp_element->effective_sizes.top()) : element->word();
+        std::string w = element.word();
         if (compare(w, dest.word()) > 0)
             w = dest.word();
         if (re != nullptr)
             w = "qword";
-        if (!sx && !use_passed_storage && fp_element)
-            fp_element->effective_sizes.pop();
         storage_register& dest64 = dest.byte_equivalent(8);
         if (dest.get_size() != 8 && !dest.is_fp_register())
             as.instruct(scope->name(), "xor " + dest64.m_name + ", " + dest64.m_name);
@@ -1969,9 +1589,7 @@ namespace asc
                 ", " + (full_deref ? w + " [r12]" : src));
         }
         dpc -= lsize;
-        asc::debug("retrieved " + element->to_string() + ", stack size now " + std::to_string(dpc));
-        if (element && element->dynamic)
-            delete element;
+        asc::debug("retrieved " + element.to_string() + ", stack size now " + std::to_string(dpc));
         pop_emulation();
         if (size != nullptr)
             *size = lsize;
@@ -1980,14 +1598,13 @@ namespace asc
 
     storage_register& parser::retrieve_stack_value(storage_register& storage, bool cc, bool sx, bool use_passed_storage, int* size)
     {
-        auto* element = top_emulation();
-        auto* re = dynamic_cast<reference_element*>(element);
-        int rsize = re != nullptr ? re->get_size() : -1;
-        bool dd = re != nullptr;
+        emulated_element element = *top_emulation();
+        bool dd = element.kind == element_kinds::REFERENCE;
+        int rsize = dd ? element.get_size() : -1;
         auto& result = retrieve_stack(storage, cc, sx, use_passed_storage, size);
         if (dd && !result.is_fp_register())
         {
-            as.instruct(scope->name(), "mov" + std::string(sx ? "sx" : "") + (re->fp ? (rsize == 8 ? "sd" : "ss") : "") +
+            as.instruct(scope->name(), "mov" + std::string(sx ? "sx" : "") + (element.fp ? (rsize == 8 ? "sd" : "ss") : "") +
                 ' ' + result.byte_equivalent(rsize).m_name +
                 ", " + word(rsize) + " [" + result.byte_equivalent(8).m_name + ']');
         }
@@ -2001,25 +1618,15 @@ namespace asc
 
     void parser::forget_top()
     {
-        stackable_element* element = top_emulation();
-        dpc -= dynamic_cast<reference_element*>(element) ? 8 : element->get_size();
+        emulated_element* element = top_emulation();
+        dpc -= element->kind == element_kinds::REFERENCE ? 8 : element->get_size();
         asc::debug("forgot " + element->to_string() + " (" + std::to_string(element->get_size()) + " byte(s))");
-        if (element->dynamic)
-            delete element;
         pop_emulation();
     }
 
     bool parser::symbol_table_has(std::string name, symbol* scope)
     {
-        try
-        {
-            symbol_table_get(name, scope);
-            return true;
-        }
-        catch (std::out_of_range& e)
-        {
-            return false;
-        }
+        return symbol_table_get(name, scope) != nullptr;
     }
 
     /**
@@ -2032,41 +1639,16 @@ namespace asc
      * @return symbol*
      */
     symbol* parser::symbol_table_get(std::string name, symbol* scope)
+    {
+        lexeme_id id = find_lexeme(name);
+        return id != INVALID_LEXEME ? symbol_table_get(id, scope) : nullptr; // a name that was never interned was never declared
+    }
+
+    symbol* parser::symbol_table_get(lexeme_id id, symbol* scope)
     {
         if (scope == nullptr)
             scope = this->scope;
-        std::vector<symbol*>* found; // get symbols with this name
-        try
-        {
-            found = &(symbols.at(name));
-        }
-        catch (std::out_of_range& e)
-        {
-            return nullptr;
-        }
-        if (found->size() == 1) // if there's only one
-            return (*found)[0]; // return it
-        int priority = -1; // keep track of the best instance of this symbol's index
-        int depth = MAX_INT32; // keep track of the depth of the best instance
-        for (int i = 0; i < found->size(); i++) // iterate over the symbols with this name
-        {
-            int d = 0;
-            for (symbol* s = scope; s != nullptr; s = s->scope, d++) // iterate down ideal scope
-            {
-                if (s->name() == (*found)[i]->scope->name())
-                {
-                    if (d < depth)
-                    {
-                        priority = i;
-                        depth = d;
-                    }
-                    break;
-                }
-            }
-        }
-        if (priority == -1)
-            return nullptr;
-        return (*found)[priority];
+        return symbols.get(id, scope);
     }
 
     /**
@@ -2078,39 +1660,33 @@ namespace asc
      * @return symbol*& 
      */
     symbol* parser::symbol_table_get_imm(std::string name, symbol* scope)
+    {
+        lexeme_id id = find_lexeme(name);
+        return id != INVALID_LEXEME ? symbol_table_get_imm(id, scope) : nullptr;
+    }
+
+    symbol* parser::symbol_table_get_imm(lexeme_id id, symbol* scope)
     {
         if (scope == nullptr)
             scope = this->scope;
-        std::vector<symbol*>* found; // get symbols with this name
-        try
-        {
-            found = &(symbols.at(name));
-        }
-        catch (std::out_of_range e)
-        {
-            return nullptr;
-        }
-        for (int i = 0; i < found->size(); i++)
-        {
-            if (scope == (*found)[i]->scope)
-                return (*found)[i];
-        }
-        return nullptr;
+        return symbols.get_imm(id, scope);
     }
 
     symbol* parser::symbol_table_insert(std::string name, symbol* s)
     {
-        symbols[name].push_back(s);
+        return symbol_table_insert(intern(name), s);
+    }
+
+    symbol* parser::symbol_table_insert(lexeme_id id, symbol* s)
+    {
+        symbols.insert(id, s);
         asc::debug(s->m_name + " added to symbol table");
         return s;
     }
 
     void parser::symbol_table_delete(symbol* s)
     {
-        std::vector<symbol*>& vec = symbols[s->m_name];
-        vec.erase(std::remove(vec.begin(), vec.end(), s), vec.end());
-        if (vec.empty())
-            symbols.erase(s->m_name); // free some memory if we're not using the vector
+        symbols.remove(s->id, s);
     }
 
     symbol* parser::get_current_function()
@@ -2123,12 +1699,12 @@ namespace asc
 
     symbol* parser::floating_point_stack(int argc)
     {
-        auto ending = stack_emulation.end() - argc;
-        for (auto it = stack_emulation.end() - 1; it >= ending; it--)
+        size_t ending = stack_emulation.size() > (size_t) argc ? stack_emulation.size() - argc : 0;
+        for (size_t i = stack_emulation.size(); i > ending; i--)
         {
-            symbol* sym = dynamic_cast<symbol*>(*it);
-            if (sym != nullptr && sym->fqt.base->variant == symbol_variants::FLOATING_POINT_PRIMITIVE)
-                return sym;
+            emulated_element& element = stack_emulation[i - 1];
+            if (element.kind == element_kinds::SYMBOL && element.fp)
+                return element.sym;
         }
         return nullptr;
     }
@@ -2145,36 +1721,30 @@ namespace asc
         heap = true;
     }
 
-    stackable_element* parser::push_emulation(stackable_element* se)
+    void parser::push_emulation(emulated_element element)
     {
-        stack_emulation.push_back(se);
-        return se;
+        stack_emulation.push_back(element);
     }
 
-    stackable_element* parser::pop_emulation()
+    void parser::pop_emulation()
     {
-        if (stack_emulation.empty())
-            return nullptr;
-        auto* element = stack_emulation.back();
-        stack_emulation.pop_back();
-        return element;
+        if (!stack_emulation.empty())
+            stack_emulation.pop_back();
     }
 
-    stackable_element* parser::top_emulation()
+    // Top of the emulated stack, null if it is empty. It is only valid until the next element is pushed
+    emulated_element* parser::top_emulation()
     {
         if (stack_emulation.empty())
             return nullptr;
-        return stack_emulation.back();
+        return &stack_emulation.back();
     }
 
-    stackable_element* parser::emulation_element(int offset)
+    emulated_element* parser::emulation_element(int offset)
     {
-        if (stack_emulation.empty())
+        if (offset < 0 || (size_t) offset >= stack_emulation.size())
             return nullptr;
-        auto it = stack_emulation.end() - (offset + 1);
-        if (it < stack_emulation.begin() || it >= stack_emulation.end())
-            return nullptr;
-        return *it;
+        return &stack_emulation[stack_emulation.size() - (offset + 1)];
     }
 
     type_symbol* parser::get_type(std::string str)
@@ -2187,9 +1757,4 @@ namespace asc
             sym->variant == symbol_variants::PRIMITIVE ||
             sym->variant == symbol_variants::FLOATING_POINT_PRIMITIVE) ? dynamic_cast<type_symbol*>(sym) : nullptr;
     }
-
-    parser::~parser()
-    {
-        delete scope;
-    }
 }
\ No newline at end of file
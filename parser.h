@@ -2,84 +2,85 @@
 #define PARSER_H
 
 #include <map>
+#include <unordered_map>
+#include <unordered_set>
 #include <stack>
 
+#include "arena.h"
 #include "symbol.h"
+#include "ast.h"
 #include "asc.h"
+#include "logger.h"
 
 namespace asc
 {
-    typedef unsigned char evaluation_state;
-    const unsigned char STATE_NEUTRAL = 0;
-    const unsigned char STATE_FOUND = 1;
-    const unsigned char STATE_SYNTAX_ERROR = 2;
-
     class parser
     {
     private:
-        evaluation_state recur_func_stack_args(syntax_node*& lcurrent, bool exp);
+        evaluation_state eval_statements(statement_list& statements);
+        evaluation_state flatten_expression(expression_node* node, std::deque<rpn_element>& output);
+        evaluation_state flatten_element(expression_node* node, expression_node* receiver, rpn_element& element);
     public:
         // tracking variables
-        syntax_node* current; // syntax token being evaluated
+        compilation_context& ctx; // compilation the parser is part of, its only state outside the parser
         assembler as; // constructor for assembly code
-        std::map<std::string, std::vector<symbol*>> symbols; // symbol table
+        arena memory; // owns every symbol and stack element made while compiling, freed all at once with the parser
+        symbol_table symbols; // symbols in scope, keyed by interned name
         symbol* scope; // scope of next tokens, null if global
         symbol* ns; // namespace of current token
         int branchc; // counter for branches
+        unsigned int scopec; // counter for symbols, numbers each one with a scope id
         int slc; // string literal counter
         int fplc; // floating point literal counter
         int dpc; // data preservation counter (how much data do we need to preserve right now?)
         int dpm; // data preservation max (how many will we need at a time)
         bool heap; // has the heap been set up?
-        std::deque<stackable_element*> stack_emulation;
-
-        parser(syntax_node* root);
-
-        // utility
-        bool parseable();
-        static bool check_eof(syntax_node* node, bool silence = false);
-
-        // eval methods
-
-        // evaluate function headers
-        evaluation_state eval_function_header(syntax_node*& lcurrent, function_symbol*& result, bool use_declaration);
-        evaluation_state eval_function_header();
-
-        // evaluate if statements
-        evaluation_state eval_if_statement(syntax_node*& lcurrent);
-        evaluation_state eval_if_statement();
-        evaluation_state eval_while_statement(syntax_node*& lcurrent);
-        evaluation_state eval_while_statement();
-        evaluation_state eval_block_ending(syntax_node*& lcurrent);
+        std::vector<emulated_element> stack_emulation;
+        std::unordered_map<statement_node*, symbol*> declarations; // symbol made for each declaring statement, looked up again when it is evaluated
+        module* mod; // module being compiled, null when expressions are evaluated on their own
+        std::unordered_set<module*> imported; // modules whose exports are declared, a module used twice is declared once
+
+        parser(compilation_context& ctx);
+
+        // declare methods, each makes the symbols of a declaration without lowering anything
+        evaluation_state declare(statement_list& statements);
+        evaluation_state declare_function(function_node* node);
+        evaluation_state declare_global(variable_node* node);
+        evaluation_state declare_type(type_node* node);
+        evaluation_state declare_object(block_node* node);
+        evaluation_state declare_object_field(variable_node* node, type_symbol* obj);
+        evaluation_state declare_object_method(function_node* node, type_symbol* obj);
+        evaluation_state declare_namespace(block_node* node);
+        evaluation_state declare_module(use_node* node);
+        evaluation_state declare_interface(module_interface& iface, int line);
+        void export_interface(statement_list& statements, module_interface& out, unsigned int ns_index = NO_NAMESPACE);
+
+        // eval methods, each lowers a node of the syntax tree to assembly
+        evaluation_state eval(statement_node* node);
+        evaluation_state eval_use(use_node* node);
+        evaluation_state eval_function(function_node* node);
+        evaluation_state eval_function_header(function_node* node, function_symbol*& result);
         evaluation_state eval_block_ending();
-        evaluation_state eval_use(syntax_node*& lcurrent);
-        evaluation_state eval_use();
-        evaluation_state eval_var_declaration(syntax_node*& lcurrent);
-        evaluation_state eval_var_declaration();
-        evaluation_state eval_expression(syntax_node*& lcurrent);
-        evaluation_state eval_expression();
-        evaluation_state eval_return_statement(syntax_node*& lcurrent);
-        evaluation_state eval_return_statement();
-        evaluation_state eval_delete_statement(syntax_node*& lcurrent);
-        evaluation_state eval_delete_statement();
-        evaluation_state eval_type_construct(syntax_node*& lcurrent);
-        evaluation_state eval_type_construct();
-        evaluation_state eval_object_construct(syntax_node*& lcurrent);
-        evaluation_state eval_object_construct();
-        evaluation_state eval_object_field(syntax_node*& lcurrent, type_symbol* obj);
-        evaluation_state eval_object_method(syntax_node*& lcurrent, type_symbol* obj);
-        evaluation_state eval_namespace(syntax_node*& lcurrent);
-        evaluation_state eval_namespace();
+        evaluation_state eval_var_declaration(variable_node* node);
+        evaluation_state eval_type_construct(type_node* node);
+        evaluation_state eval_object_construct(block_node* node);
+        evaluation_state eval_namespace(block_node* node);
+        evaluation_state eval_if_statement(block_node* node);
+        evaluation_state eval_while_statement(block_node* node);
+        evaluation_state eval_return_statement(expression_statement* node);
+        evaluation_state eval_delete_statement(expression_statement* node);
+        evaluation_state eval_expression(expression_node* node);
 
         // segments of evaluation
 
         // evaluate full type
-        evaluation_state eval_full_type(syntax_node*& lcurrent, fully_qualified_type& fqt);
+        evaluation_state eval_full_type(const type_expression& type, fully_qualified_type& fqt);
+        evaluation_state eval_interface_type(const interface_type_ref& ref, module_interface& iface, int line, fully_qualified_type& fqt);
 
         // value management
         int preserve_value(storage_register& location, int size = -1, symbol* scope = nullptr);
         int preserve_symbol(symbol* sym, symbol* scope = nullptr);
-        int preserve_reference(storage_register& location, fully_qualified_type& fqt, symbol* scope = nullptr);
+        int preserve_reference(storage_register& location, type_symbol* base, int pointer_level, symbol* scope = nullptr);
         int reserve_data_space(int size);
         storage_register& retrieve_stack(storage_register& storage, bool cc = false, bool sx = false, bool use_passed_storage = false, int* size = nullptr);
         storage_register& retrieve_stack_value(storage_register& storage, bool cc = false, bool sx = false, bool use_passed_storage = false, int* size = nullptr);
@@ -89,24 +90,32 @@ namespace asc
         // symbol table methods
         bool symbol_table_has(std::string name, symbol* scope = nullptr);
         symbol* symbol_table_get(std::string name, symbol* scope = nullptr);
+        symbol* symbol_table_get(lexeme_id id, symbol* scope = nullptr);
         symbol* symbol_table_get_imm(std::string name, symbol* scope = nullptr);
+        symbol* symbol_table_get_imm(lexeme_id id, symbol* scope = nullptr);
         symbol* symbol_table_insert(std::string name, symbol* s);
+        symbol* symbol_table_insert(lexeme_id id, symbol* s);
         void symbol_table_delete(symbol* s);
 
         // utility
+        template <typename T, typename... Args> T* make_symbol(Args&&... args)
+        {
+            T* s = memory.make<T>(std::forward<Args>(args)...);
+            s->scope_id = ++scopec;
+            if (ctx.option(cli_options::SYMBOLIZE))
+                asc::info(s->to_string());
+            return s;
+        }
         symbol* get_current_function();
         symbol* floating_point_stack(int argc = 2);
         void init_heap();
-        stackable_element* push_emulation(stackable_element* se);
-        stackable_element* pop_emulation();
-        stackable_element* top_emulation();
-        stackable_element* emulation_element(int offset);
+        void push_emulation(emulated_element element);
+        void pop_emulation();
+        emulated_element* top_emulation();
+        emulated_element* emulation_element(int offset);
 
         // type management
         type_symbol* get_type(std::string str);
-
-        // destructor
-        ~parser();
     };
 }
 
@@ -0,0 +1,294 @@
+#include <algorithm>
+#include <cstring>
+
+#include "scanner.h"
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define ASC_SSE2
+#include <immintrin.h>
+#if defined(__GNUC__)
+#define ASC_AVX2
+#define ASC_TARGET_AVX2 __attribute__((target("avx2")))
+#elif defined(__AVX2__)
+#define ASC_AVX2
+#define ASC_TARGET_AVX2
+#endif
+#endif
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
+namespace asc
+{
+    namespace scan_levels
+    {
+        std::string name(scan_level level)
+        {
+            switch (level)
+            {
+                case SCALAR: return "scalar";
+                case SSE2: return "sse2";
+                case AVX2: return "avx2";
+            }
+            return "unknown";
+        }
+    }
+
+    const size_t BLOCK_SIZE = 64; // bytes classified into one set of masks
+    const size_t BATCH_BLOCKS = 256; // blocks classified before their masks are walked, keeps the masks in cache
+
+    // positions of the bytes the scanner cares about within one block, bit i is byte i
+    typedef struct block_masks
+    {
+        unsigned long long newlines;
+        unsigned long long hashes;
+        unsigned long long quotes;
+        unsigned long long backslashes;
+    } block_masks;
+
+    // lexer state carried from one block to the next
+    typedef struct scan_state
+    {
+        bool in_string;
+        bool in_comment;
+        bool escaped; // the first byte of the next block is escaped
+        size_t comment_start;
+    } scan_state;
+
+    // Index of the lowest set bit, x must not be 0
+    unsigned int trailing_zeros(unsigned long long x)
+    {
+#if defined(_MSC_VER)
+        unsigned long index;
+        _BitScanForward64(&index, x);
+        return index;
+#else
+        return __builtin_ctzll(x);
+#endif
+    }
+
+    // Drops the interesting bits before the first of the newlines, all of them if there is none
+    static unsigned long long skip_to_newline(unsigned long long interesting, unsigned long long newlines)
+    {
+        if (newlines == 0)
+            return 0;
+        return interesting & ~((newlines & (~newlines + 1)) - 1);
+    }
+
+    static void classify_scalar(const char* data, size_t blocks, block_masks* masks)
+    {
+        for (size_t b = 0; b < blocks; b++)
+        {
+            block_masks& m = masks[b];
+            m = { 0, 0, 0, 0 };
+            const char* block = data + b * BLOCK_SIZE;
+            for (size_t i = 0; i < BLOCK_SIZE; i++)
+            {
+                unsigned long long bit = 1ull << i;
+                switch (block[i])
+                {
+                    case '\n': m.newlines |= bit; break;
+                    case '#': m.hashes |= bit; break;
+                    case '"': m.quotes |= bit; break;
+                    case '\\': m.backslashes |= bit; break;
+                }
+            }
+        }
+    }
+
+#ifdef ASC_SSE2
+    static void classify_sse2(const char* data, size_t blocks, block_masks* masks)
+    {
+        const __m128i newline = _mm_set1_epi8('\n'), hash = _mm_set1_epi8('#'),
+            quote = _mm_set1_epi8('"'), backslash = _mm_set1_epi8('\\');
+        for (size_t b = 0; b < blocks; b++)
+        {
+            block_masks& m = masks[b];
+            m = { 0, 0, 0, 0 };
+            for (size_t i = 0; i < BLOCK_SIZE; i += 16)
+            {
+                __m128i bytes = _mm_loadu_si128((const __m128i*) (data + b * BLOCK_SIZE + i));
+                m.newlines |= (unsigned long long) (unsigned int) _mm_movemask_epi8(_mm_cmpeq_epi8(bytes, newline)) << i;
+                m.hashes |= (unsigned long long) (unsigned int) _mm_movemask_epi8(_mm_cmpeq_epi8(bytes, hash)) << i;
+                m.quotes |= (unsigned long long) (unsigned int) _mm_movemask_epi8(_mm_cmpeq_epi8(bytes, quote)) << i;
+                m.backslashes |= (unsigned long long) (unsigned int) _mm_movemask_epi8(_mm_cmpeq_epi8(bytes, backslash)) << i;
+            }
+        }
+    }
+#endif
+
+#ifdef ASC_AVX2
+    ASC_TARGET_AVX2 static void classify_avx2(const char* data, size_t blocks, block_masks* masks)
+    {
+        const __m256i newline = _mm256_set1_epi8('\n'), hash = _mm256_set1_epi8('#'),
+            quote = _mm256_set1_epi8('"'), backslash = _mm256_set1_epi8('\\');
+        for (size_t b = 0; b < blocks; b++)
+        {
+            block_masks& m = masks[b];
+            m = { 0, 0, 0, 0 };
+            for (size_t i = 0; i < BLOCK_SIZE; i += 32)
+            {
+                __m256i bytes = _mm256_loadu_si256((const __m256i*) (data + b * BLOCK_SIZE + i));
+                m.newlines |= (unsigned long long) (unsigned int) _mm256_movemask_epi8(_mm256_cmpeq_epi8(bytes, newline)) << i;
+                m.hashes |= (unsigned long long) (unsigned int) _mm256_movemask_epi8(_mm256_cmpeq_epi8(bytes, hash)) << i;
+                m.quotes |= (unsigned long long) (unsigned int) _mm256_movemask_epi8(_mm256_cmpeq_epi8(bytes, quote)) << i;
+                m.backslashes |= (unsigned long long) (unsigned int) _mm256_movemask_epi8(_mm256_cmpeq_epi8(bytes, backslash)) << i;
+            }
+        }
+    }
+#endif
+
+    static void classify(const char* data, size_t blocks, block_masks* masks, scan_level level)
+    {
+#ifdef ASC_AVX2
+        if (level == scan_levels::AVX2)
+            return classify_avx2(data, blocks, masks);
+#endif
+#ifdef ASC_SSE2
+        if (level >= scan_levels::SSE2)
+            return classify_sse2(data, blocks, masks);
+#endif
+        classify_scalar(data, blocks, masks);
+    }
+
+    // Sets the comment bits of every byte in [start, end)
+    static void mark_comment(source_index& index, size_t start, size_t end)
+    {
+        for (size_t word = start / BLOCK_SIZE; start < end; word++)
+        {
+            size_t word_end = std::min(end, (word + 1) * BLOCK_SIZE);
+            unsigned long long bits = word_end - start == BLOCK_SIZE ? ~0ull : ((1ull << (word_end - start)) - 1);
+            index.comment_mask[word] |= bits << (start % BLOCK_SIZE);
+            start = word_end;
+        }
+    }
+
+    // Follows string and comment state through the interesting bytes of one block
+    static void resolve(const block_masks& m, size_t base, scan_state& state, source_index& index)
+    {
+        unsigned long long interesting = m.newlines | m.hashes | m.quotes | m.backslashes;
+        if (state.escaped)
+        {
+            if (!(m.newlines & 1))
+                interesting &= ~1ull;
+            state.escaped = false;
+        }
+        if (state.in_comment) // nothing but a newline can end a comment
+            interesting = skip_to_newline(interesting, m.newlines);
+        while (interesting)
+        {
+            unsigned int i = trailing_zeros(interesting);
+            unsigned long long bit = 1ull << i;
+            interesting &= interesting - 1;
+            if (m.newlines & bit)
+            {
+                if (state.in_comment)
+                    mark_comment(index, state.comment_start, base + i);
+                state.in_string = state.in_comment = false;
+                index.line_starts.push_back(base + i + 1);
+            }
+            else if (state.in_string)
+            {
+                if (m.quotes & bit)
+                    state.in_string = false;
+                else if (m.backslashes & bit) // the byte after an escape is skipped unless it ends the line
+                {
+                    if (i == BLOCK_SIZE - 1)
+                        state.escaped = true;
+                    else if (!(m.newlines & (bit << 1)))
+                        interesting &= ~(bit << 1);
+                }
+            }
+            else if (m.quotes & bit)
+                state.in_string = true;
+            else if (m.hashes & bit)
+            {
+                state.in_comment = true;
+                state.comment_start = base + i;
+                interesting = skip_to_newline(interesting, m.newlines & ~((bit << 1) - 1));
+            }
+        }
+    }
+
+    bool source_index::in_comment(size_t offset) const
+    {
+        return offset / BLOCK_SIZE < comment_mask.size() && (comment_mask[offset / BLOCK_SIZE] >> (offset % BLOCK_SIZE) & 1);
+    }
+
+    // Line number of the byte at the offset, starting from 1
+    int source_index::line_of(size_t offset) const
+    {
+        return std::upper_bound(line_starts.begin(), line_starts.end(), offset) - line_starts.begin();
+    }
+
+    // Reads the processor's time stamp counter, 0 where there is none
+    unsigned long long cycle_count()
+    {
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+        return __rdtsc();
+#elif defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+        return __builtin_ia32_rdtsc();
+#else
+        return 0;
+#endif
+    }
+
+    scan_level best_scan_level()
+    {
+#ifdef ASC_AVX2
+#if defined(__GNUC__)
+        if (__builtin_cpu_supports("avx2"))
+            return scan_levels::AVX2;
+#else
+        return scan_levels::AVX2;
+#endif
+#endif
+#ifdef ASC_SSE2
+        return scan_levels::SSE2;
+#else
+        return scan_levels::SCALAR;
+#endif
+    }
+
+    /**
+     * @brief Builds the line index and comment mask of source code.
+     *
+     * @param data Source code to scan
+     * @param length Length of the source code in bytes
+     * @param level Instruction set to classify bytes with, must be supported by the processor
+     * @return Index of the source code
+     */
+    source_index index_source(const char* data, size_t length, scan_level level)
+    {
+        source_index index;
+        index.line_starts.push_back(0);
+        index.comment_mask.assign((length + BLOCK_SIZE - 1) / BLOCK_SIZE, 0);
+        scan_state state = { false, false, false, 0 };
+        block_masks masks[BATCH_BLOCKS];
+        size_t full_blocks = length / BLOCK_SIZE;
+        for (size_t first = 0; first < full_blocks; first += BATCH_BLOCKS)
+        {
+            size_t blocks = std::min(BATCH_BLOCKS, full_blocks - first);
+            classify(data + first * BLOCK_SIZE, blocks, masks, level);
+            for (size_t b = 0; b < blocks; b++)
+                resolve(masks[b], (first + b) * BLOCK_SIZE, state, index);
+        }
+        if (length % BLOCK_SIZE != 0) // the last partial block is padded with bytes the scanner ignores
+        {
+            char tail[BLOCK_SIZE] = {};
+            std::memcpy(tail, data + full_blocks * BLOCK_SIZE, length % BLOCK_SIZE);
+            classify(tail, 1, masks, level);
+            resolve(masks[0], full_blocks * BLOCK_SIZE, state, index);
+        }
+        if (state.in_comment) // comment at the end of the file
+            mark_comment(index, state.comment_start, length);
+        return index;
+    }
+
+    source_index index_source(const char* data, size_t length)
+    {
+        static const scan_level level = best_scan_level();
+        return index_source(data, length, level);
+    }
+}
\ No newline at end of file
@@ -0,0 +1,45 @@
+#ifndef SCANNER_H
+#define SCANNER_H
+
+#include <vector>
+#include <string>
+#include <cstddef>
+
+namespace asc
+{
+    typedef unsigned char scan_level;
+
+    // instruction sets the scanner can classify bytes with
+    namespace scan_levels
+    {
+        const scan_level SCALAR = 0;
+        const scan_level SSE2 = 1;
+        const scan_level AVX2 = 2;
+
+        std::string name(scan_level level);
+    }
+
+    /**
+     * @brief Line and comment structure of a source file, found without visiting every byte one at a time.
+     * The scanner classifies newlines, '#', '"' and '\' 64 bytes at a time with SIMD compares, then walks only
+     * those positions to follow string and comment state, using the same rules as the lexer:
+     * strings and comments end at the end of their line, and a '\' in a string escapes the byte after it.
+     */
+    class source_index
+    {
+    public:
+        std::vector<unsigned int> line_starts; // offset of the first byte of every line
+        std::vector<unsigned long long> comment_mask; // bit i of word w is set if byte 64 * w + i is part of a comment
+
+        bool in_comment(size_t offset) const;
+        int line_of(size_t offset) const;
+    };
+
+    unsigned int trailing_zeros(unsigned long long x);
+    unsigned long long cycle_count();
+    scan_level best_scan_level();
+    source_index index_source(const char* data, size_t length, scan_level level);
+    source_index index_source(const char* data, size_t length);
+}
+
+#endif
\ No newline at end of file
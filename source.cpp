@@ -0,0 +1,137 @@
+#include <fstream>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+#include "source.h"
+#include "logger.h"
+
+namespace asc
+{
+    source_file::source_file(std::string filepath)
+    {
+        this->m_data = nullptr;
+        this->m_length = 0;
+        this->mapped = false;
+#ifdef _WIN32
+        this->file_handle = INVALID_HANDLE_VALUE;
+        this->mapping_handle = nullptr;
+#endif
+        this->m_good = map(filepath) || read(filepath);
+        if (m_good)
+            asc::debug("loaded " + filepath + " (" + std::to_string(m_length) + " bytes, " + (mapped ? "mapped" : "buffered") + ')');
+    }
+
+#ifdef _WIN32
+    bool source_file::map(std::string& filepath)
+    {
+        HANDLE file = CreateFileA(filepath.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING,
+            FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+        if (file == INVALID_HANDLE_VALUE)
+            return false;
+        LARGE_INTEGER size;
+        if (!GetFileSizeEx(file, &size) || size.QuadPart == 0) // empty files cannot be mapped
+        {
+            CloseHandle(file);
+            return false;
+        }
+        HANDLE mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+        if (mapping == nullptr)
+        {
+            CloseHandle(file);
+            return false;
+        }
+        void* view = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+        if (view == nullptr)
+        {
+            CloseHandle(mapping);
+            CloseHandle(file);
+            return false;
+        }
+        file_handle = file;
+        mapping_handle = mapping;
+        m_data = static_cast<const char*>(view);
+        m_length = (size_t) size.QuadPart;
+        mapped = true;
+        return true;
+    }
+#else
+    bool source_file::map(std::string& filepath)
+    {
+        int fd = open(filepath.c_str(), O_RDONLY);
+        if (fd == -1)
+            return false;
+        struct stat st;
+        if (fstat(fd, &st) == -1 || !S_ISREG(st.st_mode) || st.st_size == 0) // empty files cannot be mapped
+        {
+            close(fd);
+            return false;
+        }
+        void* view = mmap(nullptr, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+        close(fd); // the mapping keeps its own reference to the file
+        if (view == MAP_FAILED)
+            return false;
+        madvise(view, st.st_size, MADV_SEQUENTIAL);
+        m_data = static_cast<const char*>(view);
+        m_length = st.st_size;
+        mapped = true;
+        return true;
+    }
+#endif
+
+    bool source_file::read(std::string& filepath)
+    {
+        std::ifstream is = std::ifstream(filepath, std::ios::binary | std::ios::ate);
+        if (is.fail())
+            return false;
+        std::streamoff size = is.tellg();
+        if (size < 0)
+            return false;
+        buffer.resize((size_t) size);
+        is.seekg(0);
+        if (size != 0 && !is.read(&buffer[0], size))
+            return false;
+        m_data = buffer.data();
+        m_length = buffer.length();
+        return true;
+    }
+
+    const char* source_file::data()
+    {
+        return m_data;
+    }
+
+    size_t source_file::length()
+    {
+        return m_length;
+    }
+
+    bool source_file::is_mapped()
+    {
+        return mapped;
+    }
+
+    bool source_file::good()
+    {
+        return m_good;
+    }
+
+    source_file::~source_file()
+    {
+        if (!mapped)
+            return;
+#ifdef _WIN32
+        UnmapViewOfFile(m_data);
+        CloseHandle(mapping_handle);
+        CloseHandle(file_handle);
+#else
+        munmap(const_cast<char*>(m_data), m_length);
+#endif
+    }
+}
\ No newline at end of file
@@ -0,0 +1,41 @@
+#ifndef SOURCE_H
+#define SOURCE_H
+
+#include <string>
+#include <cstddef>
+
+namespace asc
+{
+    /**
+     * @brief Read-only view of a source file's bytes. The file is memory-mapped when
+     * the platform allows it and read into a buffer with a single read otherwise.
+     * Token offsets are relative to this view.
+     */
+    class source_file
+    {
+    private:
+        const char* m_data;
+        size_t m_length;
+        bool mapped;
+        bool m_good;
+        std::string buffer; // fallback storage when the file could not be mapped
+#ifdef _WIN32
+        void* file_handle;
+        void* mapping_handle;
+#endif
+
+        bool map(std::string& filepath);
+        bool read(std::string& filepath);
+    public:
+        source_file(std::string filepath);
+        source_file(const source_file&) = delete;
+        source_file& operator=(const source_file&) = delete;
+        const char* data();
+        size_t length();
+        bool is_mapped();
+        bool good();
+        ~source_file();
+    };
+}
+
+#endif
\ No newline at end of file
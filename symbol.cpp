@@ -1,7 +1,7 @@
+#include <algorithm>
+
 #include "symbol.h"
 #include "syntax.h"
-#include "asc.h"
-#include "cli.h"
 #include "logger.h"
 
 namespace asc
@@ -42,25 +42,32 @@ namespace asc
         {
             return sv == METHOD || sv == CONSTRUCTOR_METHOD;
         }
+
+        // Whether symbols of the variant are type symbols
+        bool is_type_variant(symbol_variant sv)
+        {
+            return sv == STRUCTLIKE_TYPE || sv == OBJECT || sv == PRIMITIVE || sv == INTEGRAL_PRIMITIVE ||
+                sv == UNSIGNED_INTEGRAL_PRIMITIVE || sv == FLOATING_POINT_PRIMITIVE;
+        }
     }
 
-    std::map<std::string, asc::type_symbol> STANDARD_TYPES = {
-        { "void", { "void", {}, symbol_variants::PRIMITIVE, visibilities::INVALID, 0, nullptr, nullptr } },
-        { "byte", { "byte", {}, symbol_variants::INTEGRAL_PRIMITIVE, visibilities::INVALID, 1, nullptr, nullptr } },
-        { "ubyte", { "ubyte", {}, symbol_variants::UNSIGNED_INTEGRAL_PRIMITIVE, visibilities::INVALID, 1, nullptr, nullptr } },
-        { "bool", { "bool", {}, symbol_variants::PRIMITIVE, visibilities::INVALID, 1, nullptr, nullptr } },
-        { "char", { "char", {}, symbol_variants::PRIMITIVE, visibilities::INVALID, 1, nullptr, nullptr } },
-        { "sint", { "sint", {}, symbol_variants::INTEGRAL_PRIMITIVE, visibilities::INVALID, 2, nullptr, nullptr } },
-        { "usint", { "usint", {}, symbol_variants::UNSIGNED_INTEGRAL_PRIMITIVE, visibilities::INVALID, 2, nullptr, nullptr } },
-        { "int", { "int", {}, symbol_variants::INTEGRAL_PRIMITIVE, visibilities::INVALID, 4, nullptr, nullptr } },
-        { "uint", { "uint", {}, symbol_variants::UNSIGNED_INTEGRAL_PRIMITIVE, visibilities::INVALID, 4, nullptr, nullptr } },
-        { "lint", { "lint", {}, symbol_variants::INTEGRAL_PRIMITIVE, visibilities::INVALID, 8, nullptr, nullptr } },
-        { "ulint", { "ulint", {}, symbol_variants::UNSIGNED_INTEGRAL_PRIMITIVE, visibilities::INVALID, 8, nullptr, nullptr } },
-        { "real", { "real", {}, symbol_variants::FLOATING_POINT_PRIMITIVE, visibilities::INVALID, 4, nullptr, nullptr } },
-        { "lreal", { "lreal", {}, symbol_variants::FLOATING_POINT_PRIMITIVE, visibilities::INVALID, 8, nullptr, nullptr } },
+    const std::vector<standard_type> STANDARD_TYPES = {
+        { "void", symbol_variants::PRIMITIVE, 0 },
+        { "byte", symbol_variants::INTEGRAL_PRIMITIVE, 1 },
+        { "ubyte", symbol_variants::UNSIGNED_INTEGRAL_PRIMITIVE, 1 },
+        { "bool", symbol_variants::PRIMITIVE, 1 },
+        { "char", symbol_variants::PRIMITIVE, 1 },
+        { "sint", symbol_variants::INTEGRAL_PRIMITIVE, 2 },
+        { "usint", symbol_variants::UNSIGNED_INTEGRAL_PRIMITIVE, 2 },
+        { "int", symbol_variants::INTEGRAL_PRIMITIVE, 4 },
+        { "uint", symbol_variants::UNSIGNED_INTEGRAL_PRIMITIVE, 4 },
+        { "lint", symbol_variants::INTEGRAL_PRIMITIVE, 8 },
+        { "ulint", symbol_variants::UNSIGNED_INTEGRAL_PRIMITIVE, 8 },
+        { "real", symbol_variants::FLOATING_POINT_PRIMITIVE, 4 },
+        { "lreal", symbol_variants::FLOATING_POINT_PRIMITIVE, 8 }
     };
 
-    std::map<std::string, std::shared_ptr<asc::storage_register>> STANDARD_REGISTERS = {
+    const std::map<std::string, std::shared_ptr<asc::storage_register>> STANDARD_REGISTERS = {
         { "rax", std::shared_ptr<storage_register>(new storage_register{ "rax", 8 }) },
         { "rbx", std::shared_ptr<storage_register>(new storage_register{ "rbx", 8 }) },
         { "rcx", std::shared_ptr<storage_register>(new storage_register{ "rcx", 8 }) },
@@ -156,7 +163,7 @@ namespace asc
         return "qword";
     }
 
-    storage_register& get_register(std::string& str)
+    storage_register& get_register(const std::string& str)
     {
         try
         {
@@ -169,11 +176,6 @@ namespace asc
         }
     }
 
-    storage_register& get_register(std::string&& str)
-    {
-        return get_register(str);
-    }
-
     fp_register::fp_register(std::string name, int size): storage_register(name, size) {}
 
     std::string fp_register::to_string()
@@ -181,38 +183,7 @@ namespace asc
         return "fp_register{name=" + m_name + ", size=" + std::to_string(size) + '}';
     }
 
-    std::string fp_register::word()
-    {
-        if (effective_sizes.empty())
-            return storage_register::word();
-        return asc::word(effective_sizes.top());
-    }
-
-    stackable_element::stackable_element()
-    {
-        this->dynamic = false;
-    }
-
-    integral_literal::integral_literal(int size)
-    {
-        this->size = size;
-    }
-
-    int integral_literal::get_size()
-    {
-        return size;
-    }
-
-    std::string integral_literal::to_string()
-    {
-        return "asc::numeric_literal{size=" + std::to_string(size) + '}';
-    }
-
-    storage_register::storage_register(std::string name, int size)
-    {
-        this->m_name = name;
-        this->size = size;
-    }
+    storage_register::storage_register(std::string name, int size): m_name(name), size(size) {}
 
     int storage_register::get_size()
     {
@@ -284,17 +255,18 @@ namespace asc
     symbol::symbol(std::string name, fully_qualified_type fqt, symbol_variant variant, visibility vis, symbol* ns, symbol*& scope)
     {
         this->m_name = name;
+        this->id = asc::intern(name);
         this->fqt = fqt;
         this->variant = variant;
         this->vis = vis;
         this->scope = scope;
         this->ns = ns;
-        this->helper = nullptr;
         this->offset = 0;
         this->split_b = 0;
+        this->scope_id = 0;
+        this->depth = scope != nullptr ? scope->depth + 1 : 0;
+        this->condition = nullptr;
         this->name_identified = false;
-        if (asc::has_option_set(asc::args, asc::cli_options::SYMBOLIZE))
-            asc::info(this->to_string());
     }
 
     symbol::symbol(std::string name, fully_qualified_type fqt, symbol_variant variant, visibility vis, symbol* ns, symbol*&& scope):
@@ -380,11 +352,10 @@ namespace asc
 
     bool type_symbol::is_primitive()
     {
-        std::string n = m_name;
         return std::find_if(STANDARD_TYPES.begin(), STANDARD_TYPES.end(),
-            [n](std::pair<std::string, asc::symbol> pair) -> bool
+            [this](const standard_type& type) -> bool
             {
-                return n == pair.second.m_name;
+                return m_name == type.name;
             }) != STANDARD_TYPES.end();
     }
 
@@ -460,22 +431,199 @@ namespace asc
         return !fqt.pointer_level ? fqt.base->size : 8;
     }
 
-    reference_element::reference_element(int offset, bool fp, fully_qualified_type fqt)
+    namespace element_kinds
     {
-        this->offset = offset;
-        this->fp = fp;
-        this->fqt = fqt;
+        std::string name(element_kind kind)
+        {
+            switch (kind)
+            {
+                case SYMBOL: return "SYMBOL";
+                case REFERENCE: return "REFERENCE";
+                case REGISTER: return "REGISTER";
+                case LITERAL: return "LITERAL";
+                default: return "UNNAMED_ELEMENT_KIND_" + std::to_string(kind);
+            }
+        }
     }
 
-    std::string reference_element::to_string()
+    int emulated_element::get_size()
     {
-        return "asc::reference_element{type=" + fqt.base->m_name + asc::pointers(fqt.pointer_level) + ", offset=" + std::to_string(offset) + 
-            ", fp=" + asc::to_string(fp) + '}';
+        switch (kind)
+        {
+            case element_kinds::SYMBOL: return sym->get_size();
+            case element_kinds::REFERENCE: return pointer_level == 0 ? base->size : 8;
+            case element_kinds::REGISTER: return reg->get_size();
+            default: return size;
+        }
+    }
+
+    // Word of the value, a floating point register is read at the size it was preserved with
+    std::string emulated_element::word()
+    {
+        if (kind == element_kinds::REGISTER && fp)
+            return asc::word(size);
+        int sz = get_size();
+        if (sz == 1)
+            return "byte";
+        if (sz == 2)
+            return "word";
+        if (sz == 4)
+            return "dword";
+        return "qword";
     }
 
-    int reference_element::get_size()
+    std::string emulated_element::to_string()
     {
-        return fqt.pointer_level == 0 ? fqt.base->size : 8;
+        switch (kind)
+        {
+            case element_kinds::SYMBOL: return sym->to_string();
+            case element_kinds::REFERENCE:
+                return "asc::reference_element{type=" + base->m_name + asc::pointers(pointer_level) + ", offset=" + std::to_string(offset) +
+                    ", fp=" + asc::to_string(fp) + '}';
+            case element_kinds::REGISTER: return reg->to_string();
+            default: return "asc::numeric_literal{size=" + std::to_string(size) + '}';
+        }
+    }
+
+    emulated_element symbol_element(symbol* sym)
+    {
+        emulated_element element = {};
+        element.kind = element_kinds::SYMBOL;
+        element.fp = sym->fqt.base != nullptr && sym->fqt.base->variant == symbol_variants::FLOATING_POINT_PRIMITIVE;
+        element.sym = sym;
+        return element;
+    }
+
+    emulated_element reference_element(int offset, type_symbol* base, int pointer_level)
+    {
+        emulated_element element = {};
+        element.kind = element_kinds::REFERENCE;
+        element.fp = base->is_floating_point();
+        element.offset = offset;
+        element.pointer_level = pointer_level;
+        element.base = base;
+        return element;
+    }
+
+    emulated_element register_element(storage_register& reg, int size)
+    {
+        emulated_element element = {};
+        element.kind = element_kinds::REGISTER;
+        element.fp = reg.is_fp_register();
+        element.size = size;
+        element.reg = &reg;
+        return element;
+    }
+
+    emulated_element literal_element(int size)
+    {
+        emulated_element element = {};
+        element.kind = element_kinds::LITERAL;
+        element.size = size;
+        return element;
+    }
+
+    /**
+     * @brief Checks whether a scope is, or encloses, another.
+     * Scopes are compared by id, and only at the depth of the outer one, which is found in the open scopes
+     * when the inner scope is open and by walking up from the inner scope otherwise.
+     *
+     * @param outer Scope which may enclose the other, null for the global scope
+     * @param inner Scope which may be enclosed, null for the global scope
+     */
+    bool symbol_table::encloses(symbol* outer, symbol* inner)
+    {
+        if (outer == nullptr)
+            return true;
+        if (inner == nullptr || outer->depth > inner->depth)
+            return false;
+        if ((size_t) inner->depth < open.size() && open[inner->depth] == inner->scope_id)
+            return open[outer->depth] == outer->scope_id;
+        for (; inner->depth > outer->depth; inner = inner->scope);
+        return inner->scope_id == outer->scope_id;
+    }
+
+    // Opens a scope inside the innermost open scope
+    void symbol_table::enter_scope(symbol* scope)
+    {
+        open.resize(scope->depth);
+        open.push_back(scope->scope_id);
+    }
+
+    // Binds the name in the scope of the symbol
+    void symbol_table::insert(lexeme_id id, symbol* s)
+    {
+        bindings[id].push_back(s);
+        if (s->scope != nullptr)
+            declared[s->scope->scope_id].push_back({ id, s });
+    }
+
+    /**
+     * @brief Finds the innermost binding of a name which is visible from a scope.
+     * A name bound only once is returned wherever it was bound.
+     *
+     * @param id Name to find
+     * @param scope Scope to search from, null for the global scope
+     * @return The symbol, or null if the name is not bound in the scope or any scope enclosing it
+     */
+    symbol* symbol_table::get(lexeme_id id, symbol* scope)
+    {
+        auto it = bindings.find(id);
+        if (it == bindings.end())
+            return nullptr;
+        std::vector<symbol*>& found = it->second;
+        if (found.size() == 1)
+            return found[0];
+        for (auto candidate = found.rbegin(); candidate != found.rend(); candidate++) // innermost bindings were made last
+        {
+            if (encloses((*candidate)->scope, scope))
+                return *candidate;
+        }
+        return nullptr;
+    }
+
+    // Finds the binding of a name made in exactly the scope given
+    symbol* symbol_table::get_imm(lexeme_id id, symbol* scope)
+    {
+        auto it = bindings.find(id);
+        if (it == bindings.end())
+            return nullptr;
+        for (auto candidate = it->second.rbegin(); candidate != it->second.rend(); candidate++)
+        {
+            if ((*candidate)->scope == scope)
+                return *candidate;
+        }
+        return nullptr;
+    }
+
+    void symbol_table::remove(lexeme_id id, symbol* s)
+    {
+        auto it = bindings.find(id);
+        if (it == bindings.end())
+            return;
+        std::vector<symbol*>& found = it->second;
+        auto binding = std::find(found.rbegin(), found.rend(), s);
+        if (binding == found.rend())
+            return;
+        found.erase(std::next(binding).base());
+        if (found.empty())
+            bindings.erase(it); // free some memory if we're not using the vector
+    }
+
+    // Closes the scope, unbinding every name bound in it, innermost first
+    void symbol_table::exit_scope(symbol* scope)
+    {
+        if ((size_t) scope->depth < open.size())
+            open.resize(scope->depth);
+        auto it = declared.find(scope->scope_id);
+        if (it == declared.end())
+            return;
+        for (auto binding = it->second.rbegin(); binding != it->second.rend(); binding++)
+        {
+            asc::debug("scope out: deleted symbol " + binding->second->name());
+            remove(binding->first, binding->second);
+        }
+        declared.erase(it);
     }
 
     std::string word(int size)
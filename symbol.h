@@ -5,8 +5,11 @@
 #include <string>
 #include <stack>
 #include <set>
+#include <vector>
+#include <unordered_map>
 
 #include "syntax.h"
+#include "interner.h"
 
 namespace asc
 {
@@ -37,35 +40,23 @@ namespace asc
         std::string name(symbol_variant sv);
         bool is_function_variant(symbol_variant sv);
         bool is_method_variant(symbol_variant sv);
+        bool is_type_variant(symbol_variant sv);
     }
 
     class stackable_element
     {
-    public:
-        bool dynamic;
-    protected:
-        stackable_element();
     public:
         virtual std::string to_string() = 0;
         virtual int get_size() = 0;
         virtual std::string word();
     };
 
-    class integral_literal: public stackable_element
-    {
-    public:
-        int size;
-
-        integral_literal(int size);
-        std::string to_string() override;
-        int get_size() override;
-    };
-
+    // registers are never changed once made, so the one table of them is shared by every compilation
     class storage_register: public stackable_element
     {
     public:
-        std::string m_name;
-        int size;
+        const std::string m_name;
+        const int size;
 
         storage_register(std::string name, int size);
         std::string to_string() override;
@@ -78,19 +69,16 @@ namespace asc
     class fp_register: public storage_register
     {
     public:
-        std::stack<int> effective_sizes;
-
         fp_register(std::string name, int size);
 
         std::string to_string() override;
-        std::string word() override;
     };
 
-    extern std::map<std::string, std::shared_ptr<asc::storage_register>> STANDARD_REGISTERS;
-    storage_register& get_register(std::string& str);
-    storage_register& get_register(std::string&& str);
+    extern const std::map<std::string, std::shared_ptr<asc::storage_register>> STANDARD_REGISTERS;
+    storage_register& get_register(const std::string& str);
 
     class type_symbol; // forward declaration of type symbol
+    class expression_node;
 
     typedef struct
     {
@@ -103,14 +91,17 @@ namespace asc
     {
     public:
         std::string m_name;
+        lexeme_id id; // interned m_name
         fully_qualified_type fqt;
         symbol_variant variant;
         visibility vis;
         symbol* scope;
         symbol* ns;
-        syntax_node* helper;
+        expression_node* condition; // condition of a while loop, evaluated again at the end of each iteration
         int offset;
         int split_b;
+        unsigned int scope_id; // numbers the symbol within its compilation so scopes are told apart by integer, 0 if never numbered
+        int depth; // number of scopes enclosing the symbol
         bool name_identified;
         
         symbol(std::string name, fully_qualified_type fqt, symbol_variant variant, visibility vis, symbol* ns, symbol*& scope);
@@ -153,18 +144,72 @@ namespace asc
         function_symbol* get_method(std::string identifier);
     };
 
-    extern std::map<std::string, asc::type_symbol> STANDARD_TYPES;
+    // Type every program has, each parser makes a symbol of its own for it
+    typedef struct standard_type
+    {
+        const char* name;
+        symbol_variant variant;
+        int size;
+    } standard_type;
+
+    extern const std::vector<standard_type> STANDARD_TYPES;
 
-    class reference_element: public stackable_element
+    typedef unsigned char element_kind;
+    namespace element_kinds
     {
-    public:
-        int offset;
-        bool fp;
-        fully_qualified_type fqt;
+        const element_kind SYMBOL = 0x00; // variable, or a type, namespace, member or method named in an expression
+        const element_kind REFERENCE = 0x01; // address of a value, kept on the stack
+        const element_kind REGISTER = 0x02; // value preserved from a register
+        const element_kind LITERAL = 0x03; // integral literal
 
-        reference_element(int offset, bool fp, fully_qualified_type fqt);
-        std::string to_string() override;
-        int get_size() override;
+        std::string name(element_kind kind);
+    }
+
+    // Entry of the emulated stack, held by value and told apart by its kind instead of its class
+    typedef struct emulated_element
+    {
+        element_kind kind;
+        bool fp; // holds a floating point value
+        int size; // size of a literal, or the size a register was preserved with
+        int offset; // stack offset of a reference
+        int pointer_level; // of the value a reference points to
+        union
+        {
+            symbol* sym; // SYMBOL
+            type_symbol* base; // REFERENCE, type of the value it points to
+            storage_register* reg; // REGISTER
+        };
+
+        int get_size(); // size of the value
+        std::string word();
+        std::string to_string();
+    } emulated_element;
+
+    emulated_element symbol_element(symbol* sym);
+    emulated_element reference_element(int offset, type_symbol* base, int pointer_level);
+    emulated_element register_element(storage_register& reg, int size);
+    emulated_element literal_element(int size);
+
+    /**
+     * @brief Symbols which are in scope, by name.
+     * Each name maps to its bindings with the innermost last, and every open scope keeps the bindings declared in it,
+     * so leaving a scope unbinds exactly those instead of searching the whole table.
+     */
+    class symbol_table
+    {
+    private:
+        std::unordered_map<lexeme_id, std::vector<symbol*>> bindings;
+        std::unordered_map<unsigned int, std::vector<std::pair<lexeme_id, symbol*>>> declared; // by scope id, global bindings are never unbound so are not kept
+        std::vector<unsigned int> open; // ids of the open scopes, indexed by depth
+
+        bool encloses(symbol* outer, symbol* inner);
+    public:
+        void enter_scope(symbol* scope);
+        void insert(lexeme_id id, symbol* s);
+        symbol* get(lexeme_id id, symbol* scope);
+        symbol* get_imm(lexeme_id id, symbol* scope);
+        void remove(lexeme_id id, symbol* s);
+        void exit_scope(symbol* scope);
     };
 
     std::string word(int size);
@@ -1,85 +1,46 @@
 #include "syntax.h"
 #include "util.h"
+#include "lexicon.h"
 
 namespace asc
 {
-    std::map<std::string, expression_operator> OPERATORS = {
-        // operators which have multiple variants follow these rules:
-        // it will include its number of operands after itself in the key for it
-        // it will have an 's' if it is suffix, 'p' if it is prefix, or 'i' if it is infix
-
-        // name, precedence, operand count, association, fix
-
-        // comma
-        { ",", { ",", 1, 2, LEFT_OPERATOR_ASSOCATION, INFIX_OPERATOR, true } },
-        
-        // assignment operators
-        { "&=", { "&=", 2, 2, RIGHT_OPERATOR_ASSOCATION } },
-        { "^=", { "^=", 2, 2, RIGHT_OPERATOR_ASSOCATION } },
-        { "|=", { "|=", 2, 2, RIGHT_OPERATOR_ASSOCATION } },
-        { "<<=", { "<<=", 2, 2, RIGHT_OPERATOR_ASSOCATION } },
-        { ">>=", { ">>=", 2, 2, RIGHT_OPERATOR_ASSOCATION } },
-        { "*=", { "*=", 2, 2, RIGHT_OPERATOR_ASSOCATION } },
-        { "/=", { "/=", 2, 2, RIGHT_OPERATOR_ASSOCATION } },
-        { "%=", { "%=", 2, 2, RIGHT_OPERATOR_ASSOCATION } },
-        { "+=", { "+=", 2, 2, RIGHT_OPERATOR_ASSOCATION } },
-        { "-=", { "-=", 2, 2, RIGHT_OPERATOR_ASSOCATION } },
-        { "~=", { "~=", 2, 2, RIGHT_OPERATOR_ASSOCATION } },
-        { "=", { "=", 2, 2, RIGHT_OPERATOR_ASSOCATION } },
-
-        // ternary operator
-        { "?", { "?", 2, 3, RIGHT_OPERATOR_ASSOCATION } },
-        { ":", { ":", 2, 3, RIGHT_OPERATOR_ASSOCATION, INFIX_OPERATOR, true } },
-
-        // arithmetic, equality, and bitwise operators
-        { "||", { "||", 3, 2 } },
-        { "&&", { "&&", 4, 2 } },
-        { "==", { "==", 5, 2 } },
-        { "!=", { "!=", 5, 2 } },
-        { "<", { "<", 6, 2 } },
-        { "<=", { "<=", 6, 2 } },
-        { ">", { ">", 6, 2 } },
-        { ">=", { ">=", 6, 2 } },
-        { "<=>", { "<=>", 7, 2 } },
-        { "|", { "|", 8, 2 } },
-        { "^", { "^", 9, 2 } },
-        { "&", { "&", 10, 2 } },
-        { "<<", { "<<", 11, 2 } },
-        { ">>", { ">>", 11, 2 } },
-        { "+", { "+", 12, 2 } },
-        { "-", { "-", 12, 2 } },
-        { "*", { "*", 13, 2 } },
-        { "/", { "/", 13, 2 } },
-        { "%", { "%", 13, 2 } },
-        // precedence level 14 reserved for pointer-to-member operator cuz ion know how it works rn lol
-
-        // prefix-only unary operators
-        { "&1p", { "&", 15, 1, RIGHT_OPERATOR_ASSOCATION, PREFIX_OPERATOR } },
-        { "*1p", { "*", 15, 1, RIGHT_OPERATOR_ASSOCATION, PREFIX_OPERATOR } },
-
-        // casting operator
-        { "=>", { "=>", 15, 2 } },
-        //
-        { "!", { "!", 15, 1, RIGHT_OPERATOR_ASSOCATION, PREFIX_OPERATOR } },
-        { "~", { "~", 15, 1, RIGHT_OPERATOR_ASSOCATION, PREFIX_OPERATOR } },
-        { "+1p", { "+", 15, 1, RIGHT_OPERATOR_ASSOCATION, PREFIX_OPERATOR } },
-        { "-1p", { "-", 15, 1, RIGHT_OPERATOR_ASSOCATION, PREFIX_OPERATOR } },
-        { "++", { "++", 15, 1, RIGHT_OPERATOR_ASSOCATION, PREFIX_OPERATOR } },
-        { "--", { "--", 15, 1, RIGHT_OPERATOR_ASSOCATION, PREFIX_OPERATOR } },
-
-        // object-oriented member resolution operators
-        { ".", { ".", 16, 2, LEFT_OPERATOR_ASSOCATION }},
-        { "->", { "->", 16, 2, LEFT_OPERATOR_ASSOCATION }},
-
-        // suffix operators
-        { "[", { "[", 16, 2, LEFT_OPERATOR_ASSOCATION, SUFFIX_OPERATOR }},
-        { "]", { "]", 16, 2, LEFT_OPERATOR_ASSOCATION, SUFFIX_OPERATOR, true }},
-        { "++1s", { "++", 16, 1, LEFT_OPERATOR_ASSOCATION, SUFFIX_OPERATOR } },
-        { "--1s", { "--", 16, 1, LEFT_OPERATOR_ASSOCATION, SUFFIX_OPERATOR } },
+    namespace operators
+    {
+        // Operator each lexeme is spelled as, variants reached only from another spelling's prefix or suffix are left out
+        static std::vector<operator_id> index_spellings()
+        {
+            std::vector<bool> variant(COUNT, false);
+            for (const expression_operator& oper : OPERATOR_TABLE)
+            {
+                if (oper.prefix != NONE)
+                    variant[oper.prefix] = true;
+                if (oper.suffix != NONE)
+                    variant[oper.suffix] = true;
+            }
+            std::vector<operator_id> by_lexeme;
+            for (operator_id id = 0; id < COUNT; id++)
+            {
+                if (variant[id])
+                    continue;
+                lexeme_id lexeme = intern(OPERATOR_TABLE[id].value);
+                if (lexeme >= by_lexeme.size())
+                    by_lexeme.resize(lexeme + 1, NONE);
+                by_lexeme[lexeme] = id;
+            }
+            return by_lexeme;
+        }
 
-        // scope resolution operator
-        { "::", { "::", 17, 2, LEFT_OPERATOR_ASSOCATION } }
-    };
+        /**
+         * @brief Resolves a lexeme to the operator it is spelled as.
+         * Every spelling is interned when the table is first built, after which resolving a token is one index into it.
+         * @return The infix or only operator of the spelling, NONE if the lexeme is not an operator
+         */
+        operator_id of(lexeme_id id)
+        {
+            static const std::vector<operator_id> by_lexeme = index_spellings();
+            return id < by_lexeme.size() ? by_lexeme[id] : NONE;
+        }
+    }
 
     namespace syntax_types
     {
@@ -147,101 +108,17 @@ namespace asc
         }
     }
 
-    std::deque<std::string> STANDARD_PUNCTUATORS = {
-        "&=",
-        "^=",
-        "|=",
-        "<<=",
-        ">>=",
-        "*=",
-        "/=",
-        "%=",
-        "+=",
-        "-=",
-        "||",
-        "&&",
-        "==",
-        "!=",
-        "~=",
-        "<<",
-        ">>",
-        "<=>",
-        "=>",
-        "<=",
-        ">=",
-        "<",
-        ">",
-        "|",
-        "^",
-        "&",
-        "!",
-        "~",
-        "++",
-        "--",
-        "+",
-        "->",
-        "-",
-        "*",
-        "/",
-        "%",
-        ".",
-        "[",
-        "]",
-        "::",
-        ",",
-        "{",
-        "}",
-        "(",
-        ")",
-        ";",
-        "?",
-        ":",
-        "="
-    };
-
-    std::vector<std::string> STANDARD_KEYWORDS = {
-        "void",
-        "byte",
-        "bool",
-        "char",
-        "short",
-        "int",
-        "long",
-        "real",
-        "signed",
-        "unsigned",
-        "return",
-        "public",
-        "private",
-        "protected",
-        "if",
-        "for",
-        "while",
-        "use",
-        "native",
-        "type",
-        "extends",
-        "object"
-    };
-
-    std::string KEYWORD_REGEX_PATTERN;
-
     unsigned char is_keyword(std::string& test)
     {
-        std::cmatch results;
-        if (std::regex_match(test.c_str(), results, std::regex(KEYWORD_REGEX_PATTERN), std::regex_constants::match_default))
-            return results[0].str().length();
-        return 0;
+        return lexicon::is_keyword(test.data(), test.length()) ? test.length() : 0;
     }
 
     unsigned char is_punctuator(std::string& test)
     {
-        for (auto& punctuator : STANDARD_PUNCTUATORS)
+        for (size_t length = std::min(lexicon::LONGEST_PUNCTUATOR, test.length()); length > 0; length--)
         {
-            if (test.length() < punctuator.length())
-                continue;
-            if (punctuator == test.substr(test.length() - punctuator.length()))
-                return punctuator.length();
+            if (lexicon::is_punctuator(test.data() + test.length() - length, length))
+                return length;
         }
         return 0;
     }
@@ -257,7 +134,7 @@ namespace asc
         return -1;
     }
 
-    bool is_numerical(std::string& test)
+    bool is_numerical(const std::string& test)
     {
         if (test == ".")
             return false;
@@ -276,14 +153,14 @@ namespace asc
         return i == test.length();
     }
 
-    bool is_string_literal(std::string& test)
+    bool is_string_literal(const std::string& test)
     {
         return test.length() >= 2 && test[0] == '"' && test[test.length() - 1] == '"';
     }
 
-    bool is_number_literal(std::string& test, bool integral)
+    bool is_number_literal(const std::string& test, bool integral)
     {
-        for (char& c : test)
+        for (char c : test)
         {
             if ((c >= '0' && c <= '9') || (!integral && c == '.') || c == '-' || c == 'u' || c == 'U' ||
                     c == 'l' || c == 'L' || c == 'f' || c == 'F' || c == 'D')
@@ -293,21 +170,21 @@ namespace asc
         return true;
     }
 
-    bool is_float_literal(std::string& test)
+    bool is_float_literal(const std::string& test)
     {
         return is_number_literal(test) && test.length() >= 1 && test[test.length() - 1] == 'f';
     }
 
-    bool is_double_literal(std::string& test)
+    bool is_double_literal(const std::string& test)
     {
         return is_number_literal(test) && test.length() >= 1 && (test[test.length() - 1] == 'D' || 
             ((test[test.length() - 1] == 'D' || (test[test.length() - 1] >= '0' && test[test.length() - 1] <= '9')) && test.find('.') != std::string::npos));
     }
 
-    std::string strip_number_literal(std::string& test)
+    std::string strip_number_literal(const std::string& test)
     {
         std::string res;
-        for (char& c : test)
+        for (char c : test)
         {
             if (c == 'u' || c == 'U' || c == 'l' || c == 'L' || c == 'f' || c == 'F' || c == 'D')
                 continue;
@@ -348,35 +225,4 @@ namespace asc
     {
         return sl.length() >= 2 ? substring(sl, sl[0] == '"' ? 1 : 0, sl.length() - (sl[sl.length() - 1] == '"' ? 1 : 0)) : sl;
     }
-
-    /* class syntax_node */
-
-    syntax_node::syntax_node(syntax_node* next, unsigned short type, std::string value, int line)
-    {
-        this->next = next;
-        this->type = type;
-        this->value = new std::string(value);
-        this->line = line;
-    }
-
-    std::string syntax_node::stringify()
-    {
-        return "syntax_node{type=" + syntax_types::name(type) + ", value=" + (value != nullptr ? *value : "") + ", line=" + std::to_string(line) + "}";
-    }
-
-    bool syntax_node::operator==(std::string value)
-    {
-        return *(this->value) == value;
-    }
-
-    bool syntax_node::operator!=(std::string value)
-    {
-        return *(this->value) != value;
-    }
-
-    syntax_node::~syntax_node()
-    {
-        delete next;
-        delete value;
-    }
 }
\ No newline at end of file
@@ -4,7 +4,9 @@
 #include <string>
 #include <type_traits>
 #include <regex>
-#include <map>
+
+#include "interner.h"
+#include "tokens.h"
 
 #define LEFT_OPERATOR_ASSOCATION true
 #define RIGHT_OPERATOR_ASSOCATION false
@@ -13,11 +15,6 @@
 #define INFIX_OPERATOR 1
 #define SUFFIX_OPERATOR 2
 
-namespace asc // Forward declarations
-{
-    class syntax_node;
-}
-
 #include "symbol.h" // christ almighty
 
 namespace asc
@@ -29,30 +26,163 @@ namespace asc
 
     typedef bool operator_association;
     typedef unsigned char operator_fix;
-    typedef struct
+    typedef unsigned char operator_id;
+
+    // every operator, each variant of a spelling is an operator of its own, numbered densely to index OPERATOR_TABLE
+    namespace operators
+    {
+        const operator_id COMMA = 0;
+        const operator_id AND_ASSIGNMENT = 1;
+        const operator_id XOR_ASSIGNMENT = 2;
+        const operator_id OR_ASSIGNMENT = 3;
+        const operator_id LEFT_SHIFT_ASSIGNMENT = 4;
+        const operator_id RIGHT_SHIFT_ASSIGNMENT = 5;
+        const operator_id MULTIPLICATION_ASSIGNMENT = 6;
+        const operator_id DIVISION_ASSIGNMENT = 7;
+        const operator_id MODULO_ASSIGNMENT = 8;
+        const operator_id ADDITION_ASSIGNMENT = 9;
+        const operator_id SUBTRACTION_ASSIGNMENT = 10;
+        const operator_id ALLOCATION = 11;
+        const operator_id ASSIGNMENT = 12;
+        const operator_id TERNARY = 13;
+        const operator_id TERNARY_ELSE = 14;
+        const operator_id LOGICAL_OR = 15;
+        const operator_id LOGICAL_AND = 16;
+        const operator_id EQUAL = 17;
+        const operator_id NOT_EQUAL = 18;
+        const operator_id LESS = 19;
+        const operator_id LESS_OR_EQUAL = 20;
+        const operator_id GREATER = 21;
+        const operator_id GREATER_OR_EQUAL = 22;
+        const operator_id THREE_WAY_COMPARISON = 23;
+        const operator_id BITWISE_OR = 24;
+        const operator_id BITWISE_XOR = 25;
+        const operator_id BITWISE_AND = 26;
+        const operator_id LEFT_SHIFT = 27;
+        const operator_id RIGHT_SHIFT = 28;
+        const operator_id ADDITION = 29;
+        const operator_id SUBTRACTION = 30;
+        const operator_id MULTIPLICATION = 31;
+        const operator_id DIVISION = 32;
+        const operator_id MODULO = 33;
+        const operator_id ADDRESS = 34;
+        const operator_id DEREFERENCE = 35;
+        const operator_id CAST = 36;
+        const operator_id LOGICAL_NOT = 37;
+        const operator_id BITWISE_NOT = 38;
+        const operator_id UNARY_PLUS = 39;
+        const operator_id NEGATION = 40;
+        const operator_id PREFIX_INCREMENT = 41;
+        const operator_id PREFIX_DECREMENT = 42;
+        const operator_id MEMBER = 43;
+        const operator_id POINTER_MEMBER = 44;
+        const operator_id SUBSCRIPT = 45;
+        const operator_id SUBSCRIPT_END = 46;
+        const operator_id SUFFIX_INCREMENT = 47;
+        const operator_id SUFFIX_DECREMENT = 48;
+        const operator_id SCOPE = 49;
+        const operator_id COUNT = 50;
+        const operator_id NONE = 0xFF; // token or node which is not an operator
+
+        operator_id of(lexeme_id id);
+    }
+
+    typedef struct expression_operator
     {
-        std::string value;
+        const char* value;
         int precedence = 0;
         int operands = 2;
         operator_association association = LEFT_OPERATOR_ASSOCATION;
         operator_fix fix = INFIX_OPERATOR;
-        bool helper = false;
-        bool function = false;
+        bool helper = false; // only closes or separates operands
+        operator_id prefix = operators::NONE; // variant the spelling stands for when it starts an operand
+        operator_id suffix = operators::NONE; // variant the spelling stands for when it follows an operand
     } expression_operator;
 
+    constexpr expression_operator OPERATOR_TABLE[] = {
+        // name, precedence, operand count, association, fix, helper, prefix variant, suffix variant
+
+        // comma
+        { ",", 1, 2, LEFT_OPERATOR_ASSOCATION, INFIX_OPERATOR, true },
+
+        // assignment operators
+        { "&=", 2, 2, RIGHT_OPERATOR_ASSOCATION },
+        { "^=", 2, 2, RIGHT_OPERATOR_ASSOCATION },
+        { "|=", 2, 2, RIGHT_OPERATOR_ASSOCATION },
+        { "<<=", 2, 2, RIGHT_OPERATOR_ASSOCATION },
+        { ">>=", 2, 2, RIGHT_OPERATOR_ASSOCATION },
+        { "*=", 2, 2, RIGHT_OPERATOR_ASSOCATION },
+        { "/=", 2, 2, RIGHT_OPERATOR_ASSOCATION },
+        { "%=", 2, 2, RIGHT_OPERATOR_ASSOCATION },
+        { "+=", 2, 2, RIGHT_OPERATOR_ASSOCATION },
+        { "-=", 2, 2, RIGHT_OPERATOR_ASSOCATION },
+        { "~=", 2, 2, RIGHT_OPERATOR_ASSOCATION },
+        { "=", 2, 2, RIGHT_OPERATOR_ASSOCATION },
+
+        // ternary operator
+        { "?", 2, 3, RIGHT_OPERATOR_ASSOCATION },
+        { ":", 2, 3, RIGHT_OPERATOR_ASSOCATION, INFIX_OPERATOR, true },
+
+        // arithmetic, equality, and bitwise operators
+        { "||", 3, 2 },
+        { "&&", 4, 2 },
+        { "==", 5, 2 },
+        { "!=", 5, 2 },
+        { "<", 6, 2 },
+        { "<=", 6, 2 },
+        { ">", 6, 2 },
+        { ">=", 6, 2 },
+        { "<=>", 7, 2 },
+        { "|", 8, 2 },
+        { "^", 9, 2 },
+        { "&", 10, 2, LEFT_OPERATOR_ASSOCATION, INFIX_OPERATOR, false, operators::ADDRESS },
+        { "<<", 11, 2 },
+        { ">>", 11, 2 },
+        { "+", 12, 2, LEFT_OPERATOR_ASSOCATION, INFIX_OPERATOR, false, operators::UNARY_PLUS },
+        { "-", 12, 2, LEFT_OPERATOR_ASSOCATION, INFIX_OPERATOR, false, operators::NEGATION },
+        { "*", 13, 2, LEFT_OPERATOR_ASSOCATION, INFIX_OPERATOR, false, operators::DEREFERENCE },
+        { "/", 13, 2 },
+        { "%", 13, 2 },
+        // precedence level 14 reserved for pointer-to-member operator cuz ion know how it works rn lol
+
+        // prefix-only unary operators
+        { "&", 15, 1, RIGHT_OPERATOR_ASSOCATION, PREFIX_OPERATOR },
+        { "*", 15, 1, RIGHT_OPERATOR_ASSOCATION, PREFIX_OPERATOR },
+
+        // casting operator
+        { "=>", 15, 2 },
+        //
+        { "!", 15, 1, RIGHT_OPERATOR_ASSOCATION, PREFIX_OPERATOR },
+        { "~", 15, 1, RIGHT_OPERATOR_ASSOCATION, PREFIX_OPERATOR },
+        { "+", 15, 1, RIGHT_OPERATOR_ASSOCATION, PREFIX_OPERATOR },
+        { "-", 15, 1, RIGHT_OPERATOR_ASSOCATION, PREFIX_OPERATOR },
+        { "++", 15, 1, RIGHT_OPERATOR_ASSOCATION, PREFIX_OPERATOR, false, operators::NONE, operators::SUFFIX_INCREMENT },
+        { "--", 15, 1, RIGHT_OPERATOR_ASSOCATION, PREFIX_OPERATOR, false, operators::NONE, operators::SUFFIX_DECREMENT },
+
+        // object-oriented member resolution operators
+        { ".", 16, 2, LEFT_OPERATOR_ASSOCATION },
+        { "->", 16, 2, LEFT_OPERATOR_ASSOCATION },
+
+        // suffix operators
+        { "[", 16, 2, LEFT_OPERATOR_ASSOCATION, SUFFIX_OPERATOR },
+        { "]", 16, 2, LEFT_OPERATOR_ASSOCATION, SUFFIX_OPERATOR, true },
+        { "++", 16, 1, LEFT_OPERATOR_ASSOCATION, SUFFIX_OPERATOR },
+        { "--", 16, 1, LEFT_OPERATOR_ASSOCATION, SUFFIX_OPERATOR },
+
+        // scope resolution operator
+        { "::", 17, 2, LEFT_OPERATOR_ASSOCATION }
+    };
+
+    static_assert(sizeof(OPERATOR_TABLE) / sizeof(OPERATOR_TABLE[0]) == operators::COUNT, "every operator needs an entry in OPERATOR_TABLE");
+
     typedef struct
     {
-        std::string value;
-        expression_operator* operator_data = nullptr;
+        lexeme_id value;
+        operator_id oper = operators::NONE; // NONE unless the element is an operation
         int parameter_index = -1;
         function_symbol* function;
         bool call_start = false;
     } rpn_element;
-
-    extern std::map<std::string, expression_operator> OPERATORS;
-    extern std::deque<std::string> STANDARD_PUNCTUATORS;
-    extern std::vector<std::string> STANDARD_KEYWORDS;
-    extern std::string KEYWORD_REGEX_PATTERN;
 }
 
 #include "assembler.h"
@@ -100,36 +230,21 @@ namespace asc
 
     char get_visibility_id(std::string& test);
 
-    bool is_numerical(std::string& test);
+    bool is_numerical(const std::string& test);
 
-    bool is_string_literal(std::string& test);
+    bool is_string_literal(const std::string& test);
 
-    bool is_number_literal(std::string& test, bool integral = false);
+    bool is_number_literal(const std::string& test, bool integral = false);
     
-    bool is_float_literal(std::string& test);
+    bool is_float_literal(const std::string& test);
 
-    bool is_double_literal(std::string& test);
+    bool is_double_literal(const std::string& test);
 
-    std::string strip_number_literal(std::string& test);
+    std::string strip_number_literal(const std::string& test);
 
     int get_register_size(std::string& reg);
 
     std::string& unwrap(std::string& sl);
-
-    class syntax_node
-    {
-    public:
-        syntax_node* next;
-        unsigned short type;
-        std::string* value;
-        int line;
-
-        syntax_node(syntax_node* next, unsigned short type, std::string value, int line);
-        std::string stringify();
-        bool operator==(std::string value);
-        bool operator!=(std::string value);
-        ~syntax_node();
-    };
 }
 
 #endif
\ No newline at end of file
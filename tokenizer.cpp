@@ -1,63 +1,422 @@
+#include <array>
+#include <vector>
+#include <thread>
+#include <cstring>
+
 #include "tokenizer.h"
 #include "util.h"
 #include "syntax.h"
+#include "context.h"
+#include "source.h"
+#include "lexicon.h"
+#include "scanner.h"
+#include "cache.h"
 
 namespace asc
 {
-    std::string TOKENIZER_REGEX_PATTERN;
+    namespace char_classes
+    {
+        const unsigned char OTHER = 0;
+        const unsigned char WHITESPACE = 1;
+        const unsigned char NEWLINE = 2;
+        const unsigned char WORD = 3; // letters and underscores
+        const unsigned char DIGIT = 4;
+        const unsigned char QUOTE = 5;
+        const unsigned char COMMENT = 6;
+        const unsigned char PUNCTUATOR = 7;
+    }
+
+    // Maps every byte to the character class the lexer dispatches on
+    static std::array<unsigned char, 256> build_char_classes()
+    {
+        std::array<unsigned char, 256> classes;
+        classes.fill(char_classes::OTHER);
+        for (int c = 'a'; c <= 'z'; c++)
+            classes[c] = char_classes::WORD;
+        for (int c = 'A'; c <= 'Z'; c++)
+            classes[c] = char_classes::WORD;
+        for (int c = '0'; c <= '9'; c++)
+            classes[c] = char_classes::DIGIT;
+        classes['_'] = char_classes::WORD;
+        classes[' '] = classes['\t'] = classes['\r'] = classes['\v'] = classes['\f'] = char_classes::WHITESPACE;
+        classes['\n'] = char_classes::NEWLINE;
+        classes['"'] = char_classes::QUOTE;
+        classes['#'] = char_classes::COMMENT;
+        for (const char* punctuator : lexicon::PUNCTUATORS)
+            classes[(unsigned char) punctuator[0]] = char_classes::PUNCTUATOR;
+        return classes;
+    }
 
-    syntax_node* tokenize(std::ifstream& is)
+    static token_buffer lex_source(source_file& source, unsigned int threads)
     {
-        asc::debug("tokenizing using the following regex pattern: " + TOKENIZER_REGEX_PATTERN);
-        syntax_node* head = new asc::syntax_node(nullptr, asc::syntax_types::PROGRAM_BEGIN, "A#", 0);
-        syntax_node* current = head;
-        std::string data;
-        for (char c = is.get(), comment = false, in_string = false; is.good(); c = is.get())
+        if (threads > 1)
+            return tokenize_parallel(source.data(), source.length(), threads);
+        return tokenize(source.data(), source.length());
+    }
+
+    // Tokenizes a file with the tokenizer and token cache the compilation is set up with
+    token_buffer tokenize(compilation_context& ctx, source_file& source)
+    {
+        if (ctx.option(cli_options::REGEX_TOKENIZER))
+            return tokenize_regex(source.data(), source.length());
+        unsigned int threads = ctx.args.lex_threads;
+        if (ctx.tokens.enabled())
+            return ctx.tokens.tokenize(source, [threads](source_file& source) { return lex_source(source, threads); });
+        return lex_source(source, threads);
+    }
+
+    /**
+     * @brief Lexes one range of A# source code using a hand-written DFA.
+     * Keywords and identifiers are matched maximally, punctuators by longest match over
+     * the standard punctuators, and comments run from a '#' outside of a string to the end of the line.
+     *
+     * @param data Start of the source code, token offsets are relative to it
+     * @param begin Start of the range to lex, must be the start of a line
+     * @param end End of the range to lex, must be the end of a line or of the source code
+     * @param line Line number of the first line in the range
+     * @param strings Interner the lexemes of the range are added to
+     * @param tokens Buffer the tokens are appended to
+     * @return Line number the range ends on
+     */
+    static int lex(const char* data, const char* begin, const char* end, int line, string_interner& strings, token_buffer& tokens)
+    {
+        static const std::array<unsigned char, 256> classes = build_char_classes();
+        for (const char* p = begin; p < end;)
         {
-            if (c == '#' && !in_string)
-                comment = true;
-            if (c == '\\')
+            const char* start = p;
+            unsigned short t;
+            switch (classes[(unsigned char) *p])
             {
-                char next = is.get();
-                (data += c) += next;
-                continue;
+                case char_classes::NEWLINE:
+                {
+                    line++;
+                    p++;
+                    continue;
+                }
+                case char_classes::COMMENT:
+                {
+                    for (; p < end && *p != '\n'; p++);
+                    continue;
+                }
+                case char_classes::WORD:
+                {
+                    for (p++; p < end && (classes[(unsigned char) *p] == char_classes::WORD ||
+                        classes[(unsigned char) *p] == char_classes::DIGIT); p++);
+                    lexeme_id id = strings.intern(start, p - start);
+                    t = lexicon::is_keyword(start, p - start) ? asc::syntax_types::KEYWORD : asc::syntax_types::IDENTIFIER;
+                    tokens.push_back(t, id, start - data, line);
+                    continue;
+                }
+                case char_classes::DIGIT:
+                {
+                    // numeric literals carry their suffixes (and hex/binary digits) with them,
+                    // plus one fractional part if the dot is followed by a digit
+                    bool fraction = false;
+                    for (p++; p < end; p++)
+                    {
+                        unsigned char cc = classes[(unsigned char) *p];
+                        if (cc == char_classes::WORD || cc == char_classes::DIGIT)
+                            continue;
+                        if (*p == '.' && !fraction && p + 1 < end && classes[(unsigned char) p[1]] == char_classes::DIGIT)
+                        {
+                            fraction = true;
+                            continue;
+                        }
+                        break;
+                    }
+                    lexeme_id id = strings.intern(start, p - start);
+                    t = is_number_literal(strings.get(id)) ? asc::syntax_types::CONSTANT : asc::syntax_types::IDENTIFIER;
+                    tokens.push_back(t, id, start - data, line);
+                    continue;
+                }
+                case char_classes::QUOTE:
+                {
+                    for (p++; p < end && *p != '"' && *p != '\n'; p++)
+                    {
+                        if (*p == '\\' && p + 1 < end && p[1] != '\n')
+                            p++;
+                    }
+                    if (p >= end || *p != '"') // unterminated string, drop it like the rest of the line
+                        continue;
+                    p++;
+                    tokens.push_back(asc::syntax_types::STRING_LITERAL, strings.intern(start, p - start), start - data, line);
+                    continue;
+                }
+                case char_classes::PUNCTUATOR:
+                {
+                    size_t matched = lexicon::match_punctuator(p, end);
+                    if (matched == 0)
+                    {
+                        p++;
+                        continue;
+                    }
+                    p += matched;
+                    tokens.push_back(asc::syntax_types::PUNCTUATOR, strings.intern(start, p - start), start - data, line);
+                    continue;
+                }
+                default: // whitespace and characters which cannot start a token
+                {
+                    p++;
+                    continue;
+                }
             }
-            if (c == '"')
-                in_string = !in_string;
-            if (c == '\n')
+        }
+        return line;
+    }
+
+    /**
+     * @brief Tokenizes A# source code in a single linear pass.
+     *
+     * @param data Source code to tokenize, token offsets are relative to it
+     * @param length Length of the source code in bytes
+     * @return Buffer holding every token in the source code
+     */
+    token_buffer tokenize(const char* data, size_t length)
+    {
+        token_buffer tokens;
+        tokens.reserve(length / 4); // roughly one token per four bytes of typical source
+        {
+            std::lock_guard<std::mutex> guard(interner().lock); // held for the whole file instead of for every token
+            lex(data, data, data + length, 1, interner(), tokens);
+        }
+        asc::debug("tokenized file successfully");
+        return tokens;
+    }
+
+    // Lexes source code a few kilobytes of whole lines at a time, as a streamed token buffer asks for tokens
+    class streaming_lexer : public token_source
+    {
+    private:
+        const char* data;
+        const char* position;
+        const char* end;
+        int line;
+    public:
+        streaming_lexer(const char* data, size_t length)
+        {
+            this->data = data;
+            this->position = data;
+            this->end = data + length;
+            this->line = 1;
+        }
+
+        bool pull(token_buffer& tokens) override
+        {
+            const size_t STREAM_CHUNK_SIZE = 1 << 12;
+            if (position >= end)
+                return false;
+            const char* stop = end;
+            if ((size_t) (end - position) > STREAM_CHUNK_SIZE)
             {
-                comment = false;
-                data += c;
-                continue;
+                const char* newline = (const char*) std::memchr(position + STREAM_CHUNK_SIZE, '\n', end - position - STREAM_CHUNK_SIZE);
+                if (newline != nullptr)
+                    stop = newline + 1;
             }
-            if (comment)
-                continue;
-            data += c;
+            std::lock_guard<std::mutex> guard(interner().lock);
+            line = lex(data, position, stop, line, interner(), tokens);
+            position = stop;
+            return true;
         }
-        std::smatch sm;
-        for (int line = 1, sl = 0, el = data.find('\n', sl);; line++, sl = el + 1, el = data.find('\n', sl))
+    };
+
+    /**
+     * @brief Creates a token buffer which tokenizes the source code while it is being read.
+     * The source file must outlive the buffer.
+     *
+     * @param source Source code to tokenize
+     * @return Streamed token buffer, holding no tokens until a cursor reaches them
+     */
+    token_buffer stream_tokens(source_file& source)
+    {
+        token_buffer tokens;
+        tokens.source.reset(new streaming_lexer(source.data(), source.length()));
+        return tokens;
+    }
+
+    // Runs work(i) for every i below count, each on its own thread
+    template <typename F> static void run_chunks(size_t count, F work)
+    {
+        std::vector<std::thread> workers;
+        for (size_t i = 1; i < count; i++)
+            workers.emplace_back(work, i);
+        work(0);
+        for (auto& worker : workers)
+            worker.join();
+    }
+
+    /**
+     * @brief Tokenizes A# source code by splitting it into chunks of whole lines lexed on separate threads.
+     * Strings and comments never span a newline, so the lexer is in its start state at every line and
+     * a chunk needs no state from the chunks before it. Each chunk interns into its own table, and the tables
+     * are merged in chunk order afterwards, so the result is identical to the serial tokenizer, lexeme ids included.
+     *
+     * @param data Source code to tokenize, token offsets are relative to it
+     * @param length Length of the source code in bytes
+     * @param threads Maximum amount of threads to lex with
+     * @return Buffer holding every token in the source code
+     */
+    token_buffer tokenize_parallel(const char* data, size_t length, unsigned int threads)
+    {
+        const size_t MINIMUM_CHUNK_SIZE = 1 << 16; // smaller chunks cost more in thread startup than they save
+        size_t chunk_count = std::min<size_t>(threads, length / MINIMUM_CHUNK_SIZE);
+        if (chunk_count <= 1)
+            return tokenize(data, length);
+        std::vector<const char*> bounds = { data };
+        for (size_t i = 1; i < chunk_count; i++)
         {
-            if (sl >= data.length())
+            const char* split = std::max(bounds.back(), data + length * i / chunk_count);
+            const char* newline = (const char*) std::memchr(split, '\n', data + length - split);
+            if (newline == nullptr)
                 break;
-            if (el == std::string::npos) el = data.length() - 1;
-            std::string ln = data.substr(sl, el - sl + ((el == data.length() - 1) ? 1 : 0));
-            for (std::regex reg = std::regex(TOKENIZER_REGEX_PATTERN, std::regex::ECMAScript);
-                std::regex_search(ln, sm, reg); ln = sm.suffix())
+            bounds.push_back(newline + 1);
+        }
+        bounds.push_back(data + length);
+        chunk_count = bounds.size() - 1;
+        std::vector<token_buffer> chunks(chunk_count);
+        std::vector<string_interner> strings(chunk_count);
+        std::vector<int> line_counts(chunk_count);
+        run_chunks(chunk_count, [&](size_t i)
+        {
+            chunks[i].reserve((bounds[i + 1] - bounds[i]) / 4);
+            line_counts[i] = lex(data, bounds[i], bounds[i + 1], 1, strings[i], chunks[i]) - 1;
+        });
+        // interning every chunk's lexemes in chunk order hands out ids in the order the serial tokenizer would
+        std::vector<std::vector<lexeme_id>> ids(chunk_count);
+        std::vector<size_t> starts(chunk_count + 1, 0);
+        std::vector<int> first_lines(chunk_count, 0);
+        std::unique_lock<std::mutex> guard(interner().lock); // the chunks' tables are private, only the shared one is locked
+        for (size_t i = 0; i < chunk_count; i++)
+        {
+            for (lexeme_id id = 0; id < strings[i].size(); id++)
+            {
+                const std::string& value = strings[i].get(id);
+                ids[i].push_back(interner().intern(value.data(), value.length()));
+            }
+            starts[i + 1] = starts[i] + chunks[i].size();
+            if (i + 1 < chunk_count)
+                first_lines[i + 1] = first_lines[i] + line_counts[i];
+        }
+        guard.unlock();
+        token_buffer tokens;
+        tokens.types.resize(starts.back());
+        tokens.ids.resize(starts.back());
+        tokens.offsets.resize(starts.back());
+        tokens.lines.resize(starts.back());
+        run_chunks(chunk_count, [&](size_t i)
+        {
+            token_buffer& chunk = chunks[i];
+            std::copy(chunk.types.begin(), chunk.types.end(), tokens.types.begin() + starts[i]);
+            std::copy(chunk.offsets.begin(), chunk.offsets.end(), tokens.offsets.begin() + starts[i]);
+            for (size_t j = 0; j < chunk.size(); j++)
+            {
+                tokens.ids[starts[i] + j] = ids[i][chunk.ids[j]];
+                tokens.lines[starts[i] + j] = chunk.lines[j] + first_lines[i];
+            }
+        });
+        asc::debug("tokenized file successfully across " + std::to_string(chunk_count) + " threads");
+        return tokens;
+    }
+
+    /**
+     * @brief Applies an edit to source code and brings its tokens up to date without tokenizing the whole file again.
+     * Only the lines the edit touches are lexed, since no token, string or comment spans a newline.
+     * The new tokens are spliced in place of the old ones on those lines and the tokens after them are
+     * shifted by the change in bytes and lines, so the work is one lex of the edited lines plus one pass over the tail.
+     *
+     * @param source Source code the tokens were made from, the edit is applied to it
+     * @param tokens Tokens of the source code before the edit, updated to match it after the edit
+     * @param edit Edit to apply, clamped to the end of the source code
+     */
+    void retokenize(std::string& source, token_buffer& tokens, const source_edit& edit)
+    {
+        size_t offset = std::min(edit.offset, source.length());
+        size_t length = std::min(edit.length, source.length() - offset);
+        // widen the edit to whole lines
+        size_t line_start = offset == 0 ? std::string::npos : source.rfind('\n', offset - 1);
+        line_start = line_start == std::string::npos ? 0 : line_start + 1;
+        size_t line_end = source.find('\n', offset + length);
+        if (line_end == std::string::npos)
+            line_end = source.length();
+        auto first = std::lower_bound(tokens.offsets.begin(), tokens.offsets.end(), line_start) - tokens.offsets.begin();
+        auto last = std::lower_bound(tokens.offsets.begin(), tokens.offsets.end(), line_end) - tokens.offsets.begin();
+        int line = 1;
+        if (first > 0) // count forward from the last token before the edited lines
+            line = tokens.lines[first - 1] + std::count(source.begin() + tokens.offsets[first - 1], source.begin() + line_start, '\n');
+        else
+            line += std::count(source.begin(), source.begin() + line_start, '\n');
+        long long byte_delta = (long long) edit.replacement.length() - (long long) length;
+        int line_delta = std::count(edit.replacement.begin(), edit.replacement.end(), '\n') -
+            std::count(source.begin() + offset, source.begin() + offset + length, '\n');
+        source.replace(offset, length, edit.replacement);
+        token_buffer relexed;
+        std::unique_lock<std::mutex> guard(interner().lock);
+        lex(source.data(), source.data() + line_start, source.data() + line_end + byte_delta, line, interner(), relexed);
+        guard.unlock();
+        tokens.types.erase(tokens.types.begin() + first, tokens.types.begin() + last);
+        tokens.types.insert(tokens.types.begin() + first, relexed.types.begin(), relexed.types.end());
+        tokens.ids.erase(tokens.ids.begin() + first, tokens.ids.begin() + last);
+        tokens.ids.insert(tokens.ids.begin() + first, relexed.ids.begin(), relexed.ids.end());
+        tokens.offsets.erase(tokens.offsets.begin() + first, tokens.offsets.begin() + last);
+        tokens.offsets.insert(tokens.offsets.begin() + first, relexed.offsets.begin(), relexed.offsets.end());
+        tokens.lines.erase(tokens.lines.begin() + first, tokens.lines.begin() + last);
+        tokens.lines.insert(tokens.lines.begin() + first, relexed.lines.begin(), relexed.lines.end());
+        for (size_t i = first + relexed.size(); i < tokens.size(); i++)
+        {
+            tokens.offsets[i] += byte_delta;
+            tokens.lines[i] += line_delta;
+        }
+    }
+
+    // Builds the alternation the regex tokenizer matches with: keywords, strings, numbers, punctuators and identifiers
+    static std::string build_regex_pattern()
+    {
+        std::string pattern;
+        for (const char* keyword : lexicon::KEYWORDS)
+            pattern += (pattern.length() != 0 ? "|" : "") + std::string(keyword);
+        pattern += "|\\\"[^\\\"\\\\\\\\]*(\\\\\\\\.[^\\\"\\\\\\\\]*)*\\\"";
+        pattern += "|\\b0x[a-fA-F0-9]+L*l*|0b[0-1]+L*l*|[0-9]+\\.[0-9]+D*F*d*f*|[0-9]+D*F*d*f*L*l*\\b";
+        for (const char* punctuator : lexicon::PUNCTUATORS)
+            pattern += '|' + escape_chars_regex(std::string(punctuator));
+        pattern += "|\\w+";
+        return pattern;
+    }
+
+    token_buffer tokenize_regex(const char* data, size_t length)
+    {
+        static const std::string pattern = build_regex_pattern();
+        asc::debug("tokenizing using the following regex pattern: " + pattern);
+        token_buffer tokens;
+        // comments are blanked out rather than removed so offsets into the stripped copy are offsets into the source
+        source_index index = index_source(data, length);
+        std::string stripped = std::string(data, length);
+        for (size_t word = 0; word < index.comment_mask.size(); word++)
+        {
+            for (unsigned long long bits = index.comment_mask[word]; bits != 0; bits &= bits - 1)
+                stripped[word * 64 + trailing_zeros(bits)] = ' ';
+        }
+        static const std::regex reg = std::regex(pattern, std::regex::ECMAScript);
+        std::cmatch cm;
+        for (size_t line = 1; line <= index.line_starts.size() && index.line_starts[line - 1] < length; line++)
+        {
+            size_t sl = index.line_starts[line - 1];
+            size_t el = line < index.line_starts.size() ? index.line_starts[line] - 1 : length;
+            for (const char* ln = stripped.c_str() + sl, *eln = stripped.c_str() + el;
+                std::regex_search(ln, eln, cm, reg); ln = cm[0].second)
             {
-                std::string c = sm.str();
+                std::string c = cm.str();
                 unsigned short t = asc::syntax_types::IDENTIFIER;
                 if (is_number_literal(c))
                     t = asc::syntax_types::CONSTANT;
-                else if (std::find(std::begin(STANDARD_PUNCTUATORS), std::end(STANDARD_PUNCTUATORS), c) != std::end(STANDARD_PUNCTUATORS))
+                else if (lexicon::is_punctuator(c.data(), c.length()))
                     t = asc::syntax_types::PUNCTUATOR;
                 else if (is_string_literal(c))
                     t = asc::syntax_types::STRING_LITERAL;
-                else if (std::find(std::begin(STANDARD_KEYWORDS), std::end(STANDARD_KEYWORDS), c) != std::end(STANDARD_KEYWORDS))
+                else if (lexicon::is_keyword(c.data(), c.length()))
                     t = asc::syntax_types::KEYWORD;
-                current = current->next = new syntax_node(nullptr, t, c, line);
+                tokens.push_back(t, intern(c), cm[0].first - stripped.c_str(), line);
             }
         }
         asc::debug("tokenized file successfully");
-        return head->next;
+        return tokens;
     }
 }
\ No newline at end of file
@@ -6,13 +6,29 @@
 #include <map>
 #include <algorithm>
 
+#include "tokens.h"
+
 namespace asc
 {
-    extern std::string TOKENIZER_REGEX_PATTERN;
+    class source_file;
+    class compilation_context;
+
+    const unsigned int LEXER_VERSION = 1; // raise whenever the lexer starts producing different tokens, invalidates cached tokens
 
-    class syntax_node;
+    // Replacement of the bytes in [offset, offset + length) of some source code with new text
+    typedef struct source_edit
+    {
+        size_t offset;
+        size_t length;
+        std::string replacement;
+    } source_edit;
 
-    syntax_node* tokenize(std::ifstream& is);
+    token_buffer tokenize(compilation_context& ctx, source_file& source);
+    token_buffer tokenize(const char* data, size_t length);
+    token_buffer tokenize_parallel(const char* data, size_t length, unsigned int threads);
+    token_buffer tokenize_regex(const char* data, size_t length);
+    token_buffer stream_tokens(source_file& source);
+    void retokenize(std::string& source, token_buffer& tokens, const source_edit& edit);
 }
 
 #endif
\ No newline at end of file
@@ -0,0 +1,145 @@
+#include <algorithm>
+
+#include "tokens.h"
+#include "syntax.h"
+
+namespace asc
+{
+    token_source::~token_source() {}
+
+    /* class token_buffer */
+
+    token_buffer::token_buffer()
+    {
+        this->base = 0;
+    }
+
+    void token_buffer::push_back(unsigned short type, lexeme_id id, unsigned int offset, int line)
+    {
+        types.push_back((unsigned char) type);
+        ids.push_back(id);
+        offsets.push_back(offset);
+        lines.push_back(line);
+    }
+
+    void token_buffer::reserve(size_t count)
+    {
+        types.reserve(count);
+        ids.reserve(count);
+        offsets.reserve(count);
+        lines.reserve(count);
+    }
+
+    size_t token_buffer::size() const
+    {
+        return ids.size();
+    }
+
+    // Whether the token at the index exists, pulling tokens from the source until it does
+    bool token_buffer::has(size_t index)
+    {
+        while (index >= base + ids.size())
+        {
+            if (source == nullptr)
+                return false;
+            if (!source->pull(*this))
+                source.reset();
+        }
+        return true;
+    }
+
+    // Releases the tokens before the index, cursors must not read them afterwards
+    void token_buffer::release(size_t index)
+    {
+        if (index <= base)
+            return;
+        size_t count = std::min(index - base, ids.size());
+        if (count * 2 < ids.size()) // dropping tokens moves the rest, so wait until that costs no more than what is dropped
+            return;
+        types.erase(types.begin(), types.begin() + count);
+        ids.erase(ids.begin(), ids.begin() + count);
+        offsets.erase(offsets.begin(), offsets.begin() + count);
+        lines.erase(lines.begin(), lines.begin() + count);
+        base += count;
+    }
+
+    token_cursor token_buffer::begin()
+    {
+        return token_cursor(this, 0);
+    }
+
+    /* class token_cursor */
+
+    token_cursor::token_cursor()
+    {
+        this->buffer = nullptr;
+        this->index = 0;
+    }
+
+    token_cursor::token_cursor(token_buffer* buffer, unsigned int index)
+    {
+        this->buffer = buffer;
+        this->index = index;
+    }
+
+    bool token_cursor::eof() const
+    {
+        return buffer == nullptr || !buffer->has(index);
+    }
+
+    unsigned short token_cursor::type() const
+    {
+        return buffer->types[index - buffer->base];
+    }
+
+    lexeme_id token_cursor::id() const
+    {
+        return buffer->ids[index - buffer->base];
+    }
+
+    unsigned int token_cursor::offset() const
+    {
+        return buffer->offsets[index - buffer->base];
+    }
+
+    int token_cursor::line() const
+    {
+        return buffer->lines[index - buffer->base];
+    }
+
+    const std::string& token_cursor::value() const
+    {
+        return lexeme(id());
+    }
+
+    token_cursor token_cursor::next() const
+    {
+        return token_cursor(buffer, index + 1);
+    }
+
+    std::string token_cursor::stringify() const
+    {
+        return "token{type=" + syntax_types::name(type()) + ", value=" + value() + ", line=" + std::to_string(line()) + "}";
+    }
+
+    // comparisons are false at the end of the file, so a lookahead past the last token never matches
+    bool token_cursor::operator==(lexeme_id id) const
+    {
+        return !eof() && this->id() == id;
+    }
+
+    bool token_cursor::operator==(const std::string& value) const
+    {
+        return !eof() && this->value() == value;
+    }
+
+    bool token_cursor::operator!=(lexeme_id id) const
+    {
+        return !(*this == id);
+    }
+
+    bool token_cursor::operator!=(const std::string& value) const
+    {
+        return !(*this == value);
+    }
+}
\ No newline at end of file
@@ -0,0 +1,78 @@
+#ifndef TOKENS_H
+#define TOKENS_H
+
+#include <string>
+#include <vector>
+#include <memory>
+#include <cstddef>
+
+#include "interner.h"
+
+namespace asc
+{
+    class token_cursor;
+    class token_buffer;
+
+    // Producer of the tokens of a buffer which is filled while it is being read
+    class token_source
+    {
+    public:
+        virtual bool pull(token_buffer& tokens) = 0; // appends the next tokens, false once there are none left
+        virtual ~token_source();
+    };
+
+    /**
+     * @brief Token stream of a source file stored as a structure of arrays.
+     * Every token is a type, an interned lexeme, a byte offset and a line in parallel vectors,
+     * so walking the stream touches contiguous memory and freeing it is a handful of deallocations.
+     * A buffer with a source is streamed: tokens are pulled from the source when a cursor first reaches them
+     * and can be released once nothing will read them again, so only a window of the stream is held at a time.
+     */
+    class token_buffer
+    {
+    public:
+        std::vector<unsigned char> types;
+        std::vector<lexeme_id> ids;
+        std::vector<unsigned int> offsets; // byte offset of the lexeme in the source it was read from
+        std::vector<int> lines;
+        size_t base; // index of the first token held, the tokens before it were released
+        std::unique_ptr<token_source> source; // null once every token has been pulled
+
+        token_buffer();
+        void push_back(unsigned short type, lexeme_id id, unsigned int offset, int line);
+        void reserve(size_t count);
+        size_t size() const;
+        bool has(size_t index);
+        void release(size_t index);
+        token_cursor begin();
+    };
+
+    /**
+     * @brief Position of a token within a token buffer.
+     * A cursor is two words and is copied freely, which is how the parser saves a position to backtrack to.
+     * A cursor past the last token, or one without a buffer, is at the end of the file.
+     */
+    class token_cursor
+    {
+    public:
+        token_buffer* buffer;
+        unsigned int index;
+
+        token_cursor();
+        token_cursor(token_buffer* buffer, unsigned int index);
+        bool eof() const;
+        unsigned short type() const;
+        lexeme_id id() const;
+        unsigned int offset() const;
+        int line() const;
+        const std::string& value() const;
+        token_cursor next() const;
+        std::string stringify() const;
+        bool operator==(lexeme_id id) const;
+        bool operator==(const std::string& value) const;
+        bool operator!=(lexeme_id id) const;
+        bool operator!=(const std::string& value) const;
+    };
+}
+
+#endif
\ No newline at end of file
@@ -96,7 +96,7 @@ namespace asc
         for (auto it = dq.begin(); it != dq.end(); it++)
         {
             if (it != dq.begin()) str += ' ';
-            str += it->value;
+            str += lexeme(it->value);
         }
         return str;
     }